@@ -0,0 +1,161 @@
+#include <coroutine_flow/async_mutex.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+/**
+ * Coroutines of the thread pool update a shared counter under a lock. The
+ * critical section is short but not empty (a few hundred ns of work), the
+ * pool has as many workers as the hardware. Next to them independent
+ * coroutines run that don't need the lock: with std::mutex the workers are
+ * blocked while they wait for the lock, with cf::async_mutex the waiting
+ * coroutines are suspended and the workers continue with other tasks.
+ */
+namespace
+{
+constexpr std::size_t c_locking_coroutines = 64;
+constexpr std::size_t c_locks_per_coroutine = 2'000;
+constexpr std::size_t c_independent_coroutines = 2'000;
+constexpr std::size_t c_work_iterations = 200;
+
+using clock_t = std::chrono::steady_clock;
+
+// Busy work that the optimizer can't remove
+std::uint64_t do_work(std::uint64_t seed)
+{
+  for (std::size_t i = 0; i < c_work_iterations; ++i)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  return seed;
+}
+
+struct result_t
+{
+    clock_t::duration locking;
+    clock_t::duration independent;
+    std::uint64_t counter;
+};
+
+template <typename lock_t>
+result_t run(cf::schedulers::priority_thread_pool_t& thread_pool,
+             lock_t lock_fn)
+{
+  std::uint64_t counter = 0;
+  std::atomic<clock_t::time_point::rep> independent_finished{ 0 };
+  const auto start = clock_t::now();
+
+  auto locking = [&]() -> cf::task<int>
+  {
+    for (std::size_t i = 0; i < c_locks_per_coroutine; ++i)
+    {
+      auto lock = co_await lock_fn();
+      counter = do_work(counter);
+    }
+    co_return 0;
+  };
+  auto independent = [&](std::uint64_t seed) -> cf::task<int>
+  {
+    const std::uint64_t result = do_work(seed);
+    const auto now = clock_t::now().time_since_epoch().count();
+    auto last = independent_finished.load();
+    while (last < now &&
+           independent_finished.compare_exchange_weak(last, now) == false)
+    {
+    }
+    co_return static_cast<int>(result & 1);
+  };
+  auto coro = [&]() -> cf::task<int>
+  {
+    std::vector<cf::task<int>> tasks;
+    for (std::size_t i = 0; i < c_locking_coroutines; ++i)
+    {
+      tasks.push_back(locking());
+    }
+    for (std::size_t i = 0; i < c_independent_coroutines; ++i)
+    {
+      tasks.push_back(independent(i));
+    }
+    co_await cf::when_all(std::move(tasks));
+    co_return 0;
+  };
+  cf::sync_wait(coro(), &thread_pool);
+  const auto end = clock_t::now();
+  return { end - start,
+           clock_t::time_point(clock_t::duration(independent_finished)) -
+               start,
+           counter };
+}
+
+void print(std::string_view name, const result_t& result)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  using std::chrono::nanoseconds;
+  const auto operations = c_locking_coroutines * c_locks_per_coroutine;
+  std::cout << name << std::endl
+            << "  locking: "
+            << duration_cast<milliseconds>(result.locking).count() << " ms, "
+            << static_cast<double>(
+                   duration_cast<nanoseconds>(result.locking).count()) /
+                   static_cast<double>(operations)
+            << " ns/lock" << std::endl
+            << "  independent coroutines finished after "
+            << duration_cast<milliseconds>(result.independent).count()
+            << " ms" << std::endl;
+}
+
+// Locks the std::mutex in await_ready, thus the coroutine never suspends
+struct std_mutex_lock_t
+{
+    std::mutex* mutex;
+
+    bool await_ready() const
+    {
+      mutex->lock();
+      return true;
+    }
+    void await_suspend(cf::__details::suspended_task_t) const noexcept {}
+    std::unique_lock<std::mutex> await_resume() const
+    {
+      return std::unique_lock<std::mutex>(*mutex, std::adopt_lock);
+    }
+};
+} // namespace
+
+int main()
+{
+  const std::size_t thread_count =
+      std::max(2u, std::thread::hardware_concurrency());
+  cf::schedulers::priority_thread_pool_t thread_pool(thread_count);
+  std::cout << thread_count << " workers" << std::endl;
+
+  std::mutex std_mutex;
+  const result_t std_result =
+      run(thread_pool, [&] { return std_mutex_lock_t{ &std_mutex }; });
+  print("std::mutex", std_result);
+
+  cf::async_mutex async_mutex;
+  const result_t async_result =
+      run(thread_pool, [&] { return async_mutex.lock(); });
+  print("cf::async_mutex", async_result);
+
+  if (std_result.counter != async_result.counter)
+  {
+    std::cout << "The counters are different" << std::endl;
+    return 1;
+  }
+  return 0;
+}
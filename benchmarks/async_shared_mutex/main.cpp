@@ -0,0 +1,179 @@
+#include <coroutine_flow/async_mutex.hpp>
+#include <coroutine_flow/async_shared_mutex.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+/**
+ * Coroutines of the thread pool look up a shared table (reads) and rarely
+ * rewrite it (writes), the ratio is given per run. The same workload runs
+ * with std::shared_mutex (the workers are blocked while they wait), with
+ * cf::async_mutex (the readers exclude each other too) and with
+ * cf::async_shared_mutex.
+ */
+namespace
+{
+constexpr std::size_t c_coroutines = 64;
+constexpr std::size_t c_operations_per_coroutine = 5'000;
+constexpr std::size_t c_table_size = 64;
+
+using clock_t = std::chrono::steady_clock;
+using table_t = std::array<std::uint64_t, c_table_size>;
+
+std::uint64_t read_table(const table_t& table, std::uint64_t seed)
+{
+  std::uint64_t result = seed;
+  for (std::uint64_t entry : table)
+  {
+    result = result * 31 + entry;
+  }
+  return result;
+}
+
+void write_table(table_t& table, std::uint64_t seed)
+{
+  for (std::uint64_t& entry : table)
+  {
+    entry = seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+}
+
+// Locks the std::shared_mutex in await_ready, the coroutine never suspends
+template <bool shared>
+struct std_shared_mutex_lock_t
+{
+    std::shared_mutex* mutex;
+
+    bool await_ready() const
+    {
+      if constexpr (shared)
+      {
+        mutex->lock_shared();
+      }
+      else
+      {
+        mutex->lock();
+      }
+      return true;
+    }
+    void await_suspend(cf::__details::suspended_task_t) const noexcept {}
+    auto await_resume() const
+    {
+      if constexpr (shared)
+      {
+        return std::shared_lock<std::shared_mutex>(*mutex, std::adopt_lock);
+      }
+      else
+      {
+        return std::unique_lock<std::shared_mutex>(*mutex, std::adopt_lock);
+      }
+    }
+};
+
+template <typename read_lock_t, typename write_lock_t>
+clock_t::duration run(cf::schedulers::priority_thread_pool_t& thread_pool,
+                      std::size_t write_every,
+                      read_lock_t read_lock,
+                      write_lock_t write_lock)
+{
+  table_t table{};
+  std::atomic_uint64_t checksum{ 0 };
+  const auto start = clock_t::now();
+
+  auto worker = [&](std::uint64_t id) -> cf::task<int>
+  {
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < c_operations_per_coroutine; ++i)
+    {
+      if ((i + id) % write_every == 0)
+      {
+        auto lock = co_await write_lock();
+        write_table(table, i);
+      }
+      else
+      {
+        auto lock = co_await read_lock();
+        result += read_table(table, id);
+      }
+    }
+    checksum += result;
+    co_return 0;
+  };
+  auto coro = [&]() -> cf::task<int>
+  {
+    std::vector<cf::task<int>> tasks;
+    for (std::size_t i = 0; i < c_coroutines; ++i)
+    {
+      tasks.push_back(worker(i));
+    }
+    co_await cf::when_all(std::move(tasks));
+    co_return 0;
+  };
+  cf::sync_wait(coro(), &thread_pool);
+  return clock_t::now() - start;
+}
+
+void print(std::string_view name, clock_t::duration duration)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  const auto operations = c_coroutines * c_operations_per_coroutine;
+  std::cout << "  " << name << ": "
+            << static_cast<double>(
+                   duration_cast<nanoseconds>(duration).count()) /
+                   static_cast<double>(operations)
+            << " ns/operation" << std::endl;
+}
+} // namespace
+
+int main()
+{
+  const std::size_t thread_count =
+      std::max(2u, std::thread::hardware_concurrency());
+  cf::schedulers::priority_thread_pool_t thread_pool(thread_count);
+  std::cout << thread_count << " workers" << std::endl;
+
+  for (std::size_t write_every : { 1'000, 100, 10 })
+  {
+    std::cout << "1 write per " << write_every << " operations" << std::endl;
+
+    std::shared_mutex std_mutex;
+    print("std::shared_mutex",
+          run(
+              thread_pool,
+              write_every,
+              [&] { return std_shared_mutex_lock_t<true>{ &std_mutex }; },
+              [&] { return std_shared_mutex_lock_t<false>{ &std_mutex }; }));
+
+    cf::async_mutex async_mutex;
+    print("cf::async_mutex",
+          run(
+              thread_pool,
+              write_every,
+              [&] { return async_mutex.lock(); },
+              [&] { return async_mutex.lock(); }));
+
+    cf::async_shared_mutex async_shared_mutex;
+    print("cf::async_shared_mutex",
+          run(
+              thread_pool,
+              write_every,
+              [&] { return async_shared_mutex.lock_shared(); },
+              [&] { return async_shared_mutex.lock(); }));
+  }
+  return 0;
+}
@@ -0,0 +1,174 @@
+#include <coroutine_flow/__details/timer_wheel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using namespace std::chrono_literals;
+
+/**
+ * 1M outstanding timers (e.g. request timeouts) between 1ms and 10 minutes.
+ * Half of them are cancelled before they expire, as most timeouts are. The
+ * time is simulated: the wheel is advanced in 1ms steps until every timer is
+ * expired.
+ *
+ * The timer wheel is compared with a binary heap with lazy cancellation,
+ * the usual timer queue implementation.
+ */
+namespace
+{
+constexpr std::size_t c_timer_count = 1'000'000;
+constexpr auto c_max_delay = 10min;
+
+using clock_t = cf::timer_clock_t;
+
+class stopwatch_t
+{
+  public:
+    explicit stopwatch_t(std::string_view name)
+        : m_name(name)
+        , m_start(std::chrono::steady_clock::now())
+    {
+    }
+    void stop(std::size_t operations)
+    {
+      const auto elapsed = std::chrono::steady_clock::now() - m_start;
+      const auto ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+      std::cout << "  " << m_name << ": "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       elapsed)
+                       .count()
+                << " ms, "
+                << static_cast<double>(ns.count()) /
+                       static_cast<double>(operations)
+                << " ns/op" << std::endl;
+    }
+
+  private:
+    std::string_view m_name;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+std::vector<clock_t::duration> make_delays()
+{
+  std::mt19937_64 random(42);
+  std::uniform_int_distribution<std::int64_t> distribution(
+      std::chrono::duration_cast<clock_t::duration>(1ms).count(),
+      std::chrono::duration_cast<clock_t::duration>(c_max_delay).count());
+  std::vector<clock_t::duration> delays(c_timer_count);
+  for (auto& delay : delays)
+  {
+    delay = clock_t::duration(distribution(random));
+  }
+  return delays;
+}
+
+std::size_t run_timer_wheel(const std::vector<clock_t::duration>& delays)
+{
+  std::cout << "timer wheel" << std::endl;
+  const auto origin = clock_t::now();
+  cf::timer_wheel wheel(origin);
+  std::size_t expired_count = 0;
+
+  std::vector<cf::__details::timer_id_t> ids;
+  ids.reserve(delays.size());
+  stopwatch_t schedule("schedule");
+  for (const auto delay : delays)
+  {
+    ids.push_back(wheel.schedule_at(origin + delay, [&] { ++expired_count; }));
+  }
+  schedule.stop(delays.size());
+
+  stopwatch_t cancel("cancel");
+  for (std::size_t i = 0; i < ids.size(); i += 2)
+  {
+    wheel.cancel(ids[i]);
+  }
+  cancel.stop(ids.size() / 2);
+
+  stopwatch_t expire("advance + expire");
+  std::vector<std::function<void()>> expired;
+  auto now = origin;
+  while (wheel.empty() == false)
+  {
+    now += 1ms;
+    wheel.advance(now, expired);
+    for (auto& callback : expired)
+    {
+      callback();
+    }
+    expired.clear();
+  }
+  expire.stop(delays.size() / 2);
+  return expired_count;
+}
+
+std::size_t run_heap(const std::vector<clock_t::duration>& delays)
+{
+  std::cout << "binary heap" << std::endl;
+  struct timer_t
+  {
+      clock_t::time_point expiry;
+      std::size_t id;
+      std::function<void()> callback;
+
+      bool operator>(const timer_t& o) const { return expiry > o.expiry; }
+  };
+  const auto origin = clock_t::now();
+  std::priority_queue<timer_t, std::vector<timer_t>, std::greater<>> heap;
+  std::vector<bool> cancelled(delays.size(), false);
+  std::size_t expired_count = 0;
+
+  stopwatch_t schedule("schedule");
+  for (std::size_t i = 0; i < delays.size(); ++i)
+  {
+    heap.push({ origin + delays[i], i, [&] { ++expired_count; } });
+  }
+  schedule.stop(delays.size());
+
+  stopwatch_t cancel("cancel");
+  for (std::size_t i = 0; i < delays.size(); i += 2)
+  {
+    cancelled[i] = true;
+  }
+  cancel.stop(delays.size() / 2);
+
+  stopwatch_t expire("advance + expire");
+  auto now = origin;
+  while (heap.empty() == false)
+  {
+    now += 1ms;
+    while (heap.empty() == false && heap.top().expiry <= now)
+    {
+      if (cancelled[heap.top().id] == false)
+      {
+        heap.top().callback();
+      }
+      heap.pop();
+    }
+  }
+  expire.stop(delays.size() / 2);
+  return expired_count;
+}
+} // namespace
+
+int main()
+{
+  const auto delays = make_delays();
+  const std::size_t wheel_expired = run_timer_wheel(delays);
+  const std::size_t heap_expired = run_heap(delays);
+  if (wheel_expired != c_timer_count / 2 || heap_expired != c_timer_count / 2)
+  {
+    std::cout << "Unexpected number of expired timers" << std::endl;
+    return 1;
+  }
+  return 0;
+}
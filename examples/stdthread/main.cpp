@@ -1,3 +1,4 @@
+#include <coroutine_flow/async_scope.hpp>
 #include <coroutine_flow/task.hpp>
 
 #include <iostream>
@@ -41,9 +42,11 @@ int main()
               << std::endl;
     co_return 42;
   };
-  std::cout << "[main] run_async()" << std::endl;
+  std::cout << "[main] spawn()" << std::endl;
 
-  run_async(my_coro(), scheduler);
-  std::this_thread::sleep_for(std::chrono::seconds{ 3 });
+  cf::async_scope scope;
+  scope.spawn(my_coro(), scheduler);
+  // Waits exactly until my_coro is finished
+  scope.join_sync();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+// Keeps the indices of the producers and the consumers on different lines
+inline constexpr std::size_t c_cache_line_size = 64;
+
+/**
+ * Lock-free, bounded multi producer multi consumer queue (ring buffer with a
+ * sequence number per slot, as described by Dmitry Vyukov). Producers and
+ * consumers claim a position with a CAS, the sequence of the slot tells
+ * whether it's free to write (2 * position) or ready to read
+ * (2 * position + 1) at that position. The doubling keeps the two states
+ * distinct even when the capacity is 1.
+ */
+template <typename T>
+class mpmc_ring_t
+{
+    struct slot_t
+    {
+        std::atomic_uint64_t sequence;
+        std::optional<T> value;
+    };
+
+  public:
+    explicit mpmc_ring_t(std::size_t capacity)
+        : m_capacity(capacity)
+        , m_slots(std::make_unique<slot_t[]>(capacity))
+    {
+      assert(capacity > 0);
+      for (std::size_t i = 0; i < capacity; ++i)
+      {
+        m_slots[i].sequence.store(2 * i, std::memory_order_relaxed);
+      }
+    }
+    mpmc_ring_t(const mpmc_ring_t&) = delete;
+    mpmc_ring_t& operator=(const mpmc_ring_t&) = delete;
+
+    // The value is moved from only when it's pushed
+    template <typename U>
+    bool try_push(U&& value)
+    {
+      std::uint64_t position = m_push_position.load(std::memory_order_relaxed);
+      while (true)
+      {
+        slot_t& slot = m_slots[position % m_capacity];
+        const std::uint64_t sequence =
+            slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 2 * position)
+        {
+          if (m_push_position.compare_exchange_weak(
+                  position, position + 1, std::memory_order_relaxed))
+          {
+            slot.value.emplace(std::forward<U>(value));
+            slot.sequence.store(2 * position + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (sequence < 2 * position)
+        {
+          // The slot is not read yet since the previous round: full
+          return false;
+        }
+        else
+        {
+          position = m_push_position.load(std::memory_order_relaxed);
+        }
+      }
+    }
+    std::optional<T> try_pop()
+    {
+      std::uint64_t position = m_pop_position.load(std::memory_order_relaxed);
+      while (true)
+      {
+        slot_t& slot = m_slots[position % m_capacity];
+        const std::uint64_t sequence =
+            slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 2 * position + 1)
+        {
+          if (m_pop_position.compare_exchange_weak(
+                  position, position + 1, std::memory_order_relaxed))
+          {
+            std::optional<T> result = std::move(slot.value);
+            slot.value.reset();
+            slot.sequence.store(2 * (position + m_capacity),
+                                std::memory_order_release);
+            return result;
+          }
+        }
+        else if (sequence < 2 * position + 1)
+        {
+          // Nothing is written to the slot in this round: empty
+          return std::nullopt;
+        }
+        else
+        {
+          position = m_pop_position.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+  private:
+    const std::size_t m_capacity;
+    std::unique_ptr<slot_t[]> m_slots;
+    alignas(c_cache_line_size) std::atomic_uint64_t m_push_position{ 0 };
+    alignas(c_cache_line_size) std::atomic_uint64_t m_pop_position{ 0 };
+};
+
+/**
+ * Bounded single producer single consumer queue. Each side owns its index
+ * and publishes it with a release store, the other side reads it with an
+ * acquire load only when its cached copy says full (or empty), thus the
+ * usual push and pop are plain loads and stores.
+ */
+template <typename T>
+class spsc_ring_t
+{
+  public:
+    explicit spsc_ring_t(std::size_t capacity)
+        : m_capacity(capacity)
+        , m_slots(std::make_unique<std::optional<T>[]>(capacity))
+    {
+      assert(capacity > 0);
+    }
+    spsc_ring_t(const spsc_ring_t&) = delete;
+    spsc_ring_t& operator=(const spsc_ring_t&) = delete;
+
+    // The value is moved from only when it's pushed
+    template <typename U>
+    bool try_push(U&& value)
+    {
+      const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_cached_head == m_capacity)
+      {
+        m_cached_head = m_head.load(std::memory_order_acquire);
+        if (tail - m_cached_head == m_capacity)
+        {
+          return false;
+        }
+      }
+      m_slots[tail % m_capacity].emplace(std::forward<U>(value));
+      m_tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+    std::optional<T> try_pop()
+    {
+      const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+      if (head == m_cached_tail)
+      {
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cached_tail)
+        {
+          return std::nullopt;
+        }
+      }
+      std::optional<T>& slot = m_slots[head % m_capacity];
+      std::optional<T> result = std::move(slot);
+      slot.reset();
+      m_head.store(head + 1, std::memory_order_release);
+      return result;
+    }
+
+  private:
+    const std::size_t m_capacity;
+    std::unique_ptr<std::optional<T>[]> m_slots;
+    // Written by the consumer
+    alignas(c_cache_line_size) std::atomic_uint64_t m_head{ 0 };
+    std::uint64_t m_cached_tail{ 0 };
+    // Written by the producer
+    alignas(c_cache_line_size) std::atomic_uint64_t m_tail{ 0 };
+    std::uint64_t m_cached_head{ 0 };
+};
+} // namespace coroutine_flow::__details
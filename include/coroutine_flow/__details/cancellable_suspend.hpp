@@ -0,0 +1,200 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Suspension of a library awaitable that is finished either by the awaited
+ * operation or by the stop request of the task, whichever comes first. The
+ * awaitable owns it:
+ *
+ * - await_suspend calls begin, hands the resumer to the operation and
+ *   returns the result of end;
+ * - the operation calls resumer_t::resume (or resume_inline) when it's done;
+ * - await_resume calls finish, it throws operation_cancelled_error when the
+ *   stop request won.
+ *
+ * The task is resumed only after end, even when the operation or the stop
+ * request is faster than await_suspend.
+ */
+class cancellable_suspend_t
+{
+    struct state_t
+    {
+        explicit state_t(suspended_task_t task)
+            : task(std::move(task))
+        {
+        }
+
+        // The operation or the stop request, only the first one resumes
+        bool claim() noexcept
+        {
+          return claimed.exchange(true, std::memory_order_acq_rel) == false;
+        }
+        // The claimer and end; the last one continues the task
+        bool arrive() noexcept
+        {
+          return pending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+        void on_cancelled()
+        {
+          if (on_cancel)
+          {
+            std::exchange(on_cancel, nullptr)();
+          }
+        }
+
+        suspended_task_t task;
+        std::atomic_bool claimed{ false };
+        std::atomic_int pending{ 2 };
+        bool cancelled{ false };
+        // Releases the resources of the operation (e.g. the timer)
+        std::function<void()> on_cancel;
+    };
+    struct stop_handler_t
+    {
+        std::shared_ptr<state_t> state;
+
+        void operator()() const
+        {
+          if (state->claim() == false)
+          {
+            return;
+          }
+          state->cancelled = true;
+          if (state->arrive())
+          {
+            state->on_cancelled();
+            state->task.resume();
+          }
+        }
+    };
+
+  public:
+    // Resumes the task when the operation is done. It can be copied freely.
+    class resumer_t
+    {
+      public:
+        explicit resumer_t(std::shared_ptr<state_t> state)
+            : m_state(std::move(state))
+        {
+        }
+
+        void resume() const
+        {
+          if (m_state->claim() && m_state->arrive())
+          {
+            m_state->task.resume();
+          }
+        }
+        // The caller already runs on the scheduler of the task
+        void resume_inline() const
+        {
+          if (m_state->claim() && m_state->arrive())
+          {
+            m_state->task.resume_inline();
+          }
+        }
+        const task_context_t& context() const
+        {
+          return m_state->task.context();
+        }
+        // It must be set before end
+        void set_on_cancel(std::function<void()> on_cancel) const
+        {
+          m_state->on_cancel = std::move(on_cancel);
+        }
+
+      private:
+        std::shared_ptr<state_t> m_state;
+    };
+
+    cancellable_suspend_t() = default;
+    cancellable_suspend_t(cancellable_suspend_t&&) = default;
+    cancellable_suspend_t& operator=(cancellable_suspend_t&&) = default;
+
+    /**
+     * Empty when the stop is already requested, then the awaitable must not
+     * suspend (await_suspend returns false).
+     *
+     * An operation that can't be abandoned (resume_on_stop is false, e.g. the
+     * children of when_all) receives the stop request through the stop token
+     * of the task. The task is resumed only by the operation and finish
+     * throws when the stop was requested meanwhile.
+     */
+    std::optional<resumer_t> begin(suspended_task_t task,
+                                   bool resume_on_stop = true)
+    {
+      const std::stop_token stop_token = task.context().stop_token;
+      if (stop_token.stop_requested())
+      {
+        m_cancelled = true;
+        return std::nullopt;
+      }
+      m_state = std::make_shared<state_t>(std::move(task));
+      if (resume_on_stop == false)
+      {
+        m_joined_stop_token = stop_token;
+      }
+      else if (stop_token.stop_possible())
+      {
+        m_stop_callback =
+            std::make_unique<std::stop_callback<stop_handler_t>>(
+                stop_token,
+                stop_handler_t{ m_state });
+      }
+      return resumer_t(m_state);
+    }
+    /**
+     * Returns whether the task stays suspended. When the operation or the stop
+     * request was faster, the task continues immediately.
+     */
+    bool end()
+    {
+      // The state is kept, await_resume reads it.
+      const std::shared_ptr<state_t> state = m_state;
+      if (state->arrive() == false)
+      {
+        return true;
+      }
+      if (state->cancelled)
+      {
+        state->on_cancelled();
+      }
+      return false;
+    }
+    // Called by await_resume
+    void finish()
+    {
+      // Waits for a concurrently running stop handler
+      m_stop_callback.reset();
+      const std::shared_ptr<state_t> state = std::exchange(m_state, nullptr);
+      if (state != nullptr)
+      {
+        // It might reference the state of the operation
+        state->on_cancel = nullptr;
+      }
+      if (m_cancelled || (state != nullptr && state->cancelled) ||
+          m_joined_stop_token.stop_requested())
+      {
+        throw operation_cancelled_error{};
+      }
+    }
+
+  private:
+    std::shared_ptr<state_t> m_state;
+    std::unique_ptr<std::stop_callback<stop_handler_t>> m_stop_callback;
+    std::stop_token m_joined_stop_token;
+    bool m_cancelled{ false };
+};
+} // namespace coroutine_flow::__details
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <coroutine_flow/__details/continuation_data.hpp>
+#include <coroutine_flow/__details/resume_scope.hpp>
 #include <coroutine_flow/__details/testing/test_injection.hpp>
 #include <coroutine_flow/profiler.hpp>
 
@@ -72,6 +73,8 @@ class final_coroutine_t
           frame. And we are right now in that coroutine frame and just about to
           run the coroutine.
            */
+          // This awaiter lives in the suspended handle's frame, read it first.
+          auto coro = handle.coro;
           if (destroy_suspended_handle)
           {
             suspended_handle.destroy();
@@ -79,9 +82,8 @@ class final_coroutine_t
           else
           {
             // ensure that current coroutine is destroyed
-            suspended_handle.promise().set_finalizer(handle.coro);
+            suspended_handle.promise().set_finalizer(coro);
           }
-          auto coro = handle.coro;
           return coro;
         }
     };
@@ -110,6 +112,7 @@ struct final_coroutine_t::promise_t
     bool fall_through{ false };
     // final coroutine should never be referenced externally
     bool has_external_reference() const noexcept { return false; }
+    bool destroys_itself() const noexcept { return fall_through; }
 
     promise_t()
     {
@@ -156,7 +159,11 @@ struct final_coroutine_t::promise_t
     void internal_release() noexcept {};
 
     std::suspend_always initial_suspend() { return {}; }
-    final_awaiter final_suspend() noexcept { return { fall_through }; }
+    final_awaiter final_suspend() noexcept
+    {
+      resume_scope_t::on_final_suspend(handle_t::from_promise(*this));
+      return { fall_through };
+    }
     void return_void() {}
     void unhandled_exception() { std::abort(); }
 
@@ -14,6 +14,7 @@ concept continuable_promise = requires(T promise, continuation_data data) {
   { promise.get_next() } -> std::same_as<continuation_data&>;
   { promise.set_finalizer(std::declval<std::coroutine_handle<>>()) };
   { promise.has_external_reference() } -> std::convertible_to<bool>;
+  { promise.destroys_itself() } -> std::convertible_to<bool>;
   { promise.internal_release() };
 };
 
@@ -23,7 +24,22 @@ struct continuation_data
     std::move_only_function<void(continuation_data) noexcept> set_next;
     std::move_only_function<continuation_data&() noexcept> get_next;
     std::move_only_function<void() noexcept> internal_release;
+    /**
+     * Schedules a callback on the scheduler of the coroutine. It is empty
+     * when the coroutine has no scheduler (e.g. final coroutine).
+     */
+    std::move_only_function<void(std::function<void()>)> schedule;
+    /**
+     * Tells whether the coroutine moved to another scheduler. It is empty
+     * when the coroutine can't move.
+     */
+    std::move_only_function<bool() noexcept> hopped;
     bool external_referenced{ false };
+    /**
+     * The coroutine is destroyed by its final coroutine (top level coroutine
+     * of run_async/sync_wait). After resuming it, it must not be touched.
+     */
+    bool destroys_itself{ false };
 
     bool is_empty() const { return set_next == nullptr; }
     bool has_external_reference() const noexcept { return external_referenced; }
@@ -33,6 +49,8 @@ struct continuation_data
       get_next = nullptr;
       coro = nullptr;
       internal_release = nullptr;
+      schedule = nullptr;
+      hopped = nullptr;
     }
 
     template <continuable_promise other_promise_type>
@@ -42,6 +60,7 @@ struct continuation_data
       continuation_data result;
       result.coro = handler;
       result.external_referenced = handler.promise().has_external_reference();
+      result.destroys_itself = handler.promise().destroys_itself();
       result.set_next = [=](continuation_data continuation_data) noexcept
       {
         other_promise_type& promise = handler.promise();
@@ -54,6 +73,13 @@ struct continuation_data
       };
       result.internal_release = [=]() noexcept
       { handler.promise().internal_release(); };
+      if constexpr (requires { handler.promise().context.schedule({}); })
+      {
+        result.schedule = [=](std::function<void()> callback)
+        { handler.promise().context.schedule(std::move(callback)); };
+        result.hopped = [=]() noexcept
+        { return handler.promise().context.hopped; };
+      }
       return result;
     }
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <coroutine_flow/__details/resume_budget.hpp>
+#include <coroutine_flow/__details/resume_scope.hpp>
 #include <coroutine_flow/__details/scope_exit.hpp>
 #include <coroutine_flow/__details/testing/test_injection.hpp>
 #include <coroutine_flow/profiler.hpp>
@@ -8,8 +10,10 @@
 #include <coroutine>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace coroutine_flow::__details
 {
@@ -47,6 +51,25 @@ class coroutine_chain_t
       return result;
     }
 
+    /**
+     * The coroutine continues the awaiting one when it's finished. It's
+     * called before the coroutine is started, thus the link is in place
+     * before anybody can resume or finish the coroutine.
+     */
+    template <coroutine_chain_holder other_promise_type>
+    void link_to(std::coroutine_handle<other_promise_type> awaiting) noexcept
+    {
+      CF_PROFILE_SCOPE();
+      CF_ATTACH_NOTE("awaiting:", awaiting.address());
+      m_next = continuation_data::create_data(awaiting);
+    }
+    // Undoes link_to when the coroutine couldn't be started
+    void unlink() noexcept { m_next.clear(); }
+
+    /**
+     * Resumes the suspended coroutine and, when it's finished, the ones that
+     * are waiting for it.
+     */
     void continue_suspended_handle()
     {
       CF_PROFILE_SCOPE();
@@ -54,38 +77,71 @@ class coroutine_chain_t
       m_suspended_handle_stored.wait(false, std::memory_order_relaxed);
       std::atomic_thread_fence(std::memory_order_acquire);
 
-      auto suspended_handle = reset_suspended_handle();
-      const bool destroy_suspended_handle =
-          suspended_handle.value().promise().external_referenced == false;
-      suspended_handle.value().resume();
-      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
-                            task__run_async__after_resume_suspended,
-                        suspended_handle->address());
-      if (suspended_handle->done() == false)
+      if (try_consume_inline_resume() == false && reschedule_continue())
       {
         return;
       }
 
+      auto suspended_handle = reset_suspended_handle();
+      auto& suspended_promise = suspended_handle.value().promise();
+      const bool destroy_suspended_handle =
+          suspended_promise.external_referenced == false;
+      const bool destroys_itself = suspended_promise.destroys_itself();
+      [[maybe_unused]]
+      auto* suspended_address = suspended_handle.value().address();
+      const bool is_done = resume_and_check_done(*suspended_handle);
+      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
+                            task__run_async__after_resume_suspended,
+                        suspended_address);
+      if (destroys_itself)
       {
-        [[maybe_unused]]
-        auto* suspended_address = suspended_handle.value().address();
-        auto& suspended_promise = suspended_handle.value().promise();
-        suspended_promise.internal_release();
+        /*
+        Top level coroutine: when it is finished it is already destroyed and
+        nobody waits for it. When it's not, somebody else continues it.
+        */
         CF_TEST_INJECTION(__details::testing::test_injection_points_t::
                               task__run_async__after_released_suspended,
                           suspended_address);
+        return;
       }
+      if (is_done == false)
+      {
+        // It might be continued (even destroyed) by somebody else already
+        return;
+      }
+
+      continuation_data current = std::exchange(m_next, {});
+      const bool hopped = suspended_promise.context.hopped;
+      suspended_promise.internal_release();
+      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
+                            task__run_async__after_released_suspended,
+                        suspended_address);
       std::vector<std::coroutine_handle<>> handles_to_destroy;
       /*
-      We need to destroy the suspended handle. This might be the top level
-      coroutine when run_async is called and it will ensure that we destroying
-      the promise. But it also can be the top level coroutine if sync_wait is
-      called, but in this case this value is false.
+      The finished coroutine is destroyed after the awaiting one read its
+      result. Top level coroutines destroy themselves, they are never
+      continued from here.
       */
       if (destroy_suspended_handle)
       {
         handles_to_destroy.push_back(*suspended_handle);
       }
+      continue_chain(std::move(current), std::move(handles_to_destroy), hopped);
+    }
+
+  private:
+    /**
+     * Resumes the coroutines that are waiting for each other (the next one
+     * reads the result of the previous one) until one of them suspends.
+     * The finished coroutines are destroyed when they are not needed anymore.
+     * When the finished coroutine moved to another scheduler (`hopped`) the
+     * next one is not continued inline, it's scheduled on its own scheduler.
+     */
+    static void continue_chain(
+        continuation_data current,
+        std::vector<std::coroutine_handle<>> handles_to_destroy,
+        bool hopped)
+    {
       auto destroy_suspended_at_end =
           scope_exit_t{ [&]() noexcept
                         {
@@ -95,14 +151,29 @@ class coroutine_chain_t
                           }
                         } };
 
-      continuation_data current = std::exchange(m_next, {});
       while (current.is_empty() == false)
       {
         CF_PROFILE_ZONE(SetNext, "Continue next");
         CF_ATTACH_NOTE("coro: ", current.coro.address());
 
-        current.coro();
-        if (current.coro.done())
+        if ((hopped || try_consume_inline_resume() == false) &&
+            reschedule_chain(current, handles_to_destroy))
+        {
+          return;
+        }
+        const bool current_destroys_itself = current.destroys_itself;
+        [[maybe_unused]]
+        auto* current_address = current.coro.address();
+        const bool current_is_done = resume_and_check_done(current.coro);
+        CF_TEST_INJECTION(__details::testing::test_injection_points_t::
+                              task__continue_chain__after_resume,
+                          current_address);
+        if (current_destroys_itself)
+        {
+          // Top level coroutine, nobody is waiting for it.
+          break;
+        }
+        if (current_is_done)
         {
           CF_ATTACH_NOTE("Is done");
           /*
@@ -114,6 +185,7 @@ class coroutine_chain_t
           {
             handles_to_destroy.push_back(current.coro);
           }
+          hopped = current.hopped != nullptr && current.hopped();
           /*
           It might be that in the chain not the first but the last item
           is the most high level coroutine. In this case we need to let
@@ -134,22 +206,65 @@ class coroutine_chain_t
       }
     }
 
-    template <coroutine_chain_holder other_promise_type>
-    void move_into(coroutine_chain_t<other_promise_type>& o) noexcept
+    /**
+     * The inline resume budget is exhausted: the rest of the chain is
+     * continued by the scheduler of the next coroutine. Returns false when it
+     * can't be scheduled, then the chain is continued inline.
+     */
+    static bool reschedule_chain(
+        continuation_data& current,
+        std::vector<std::coroutine_handle<>>& handles_to_destroy)
     {
-      CF_PROFILE_SCOPE();
-
-      m_suspended_handle_stored.wait(false, std::memory_order_relaxed);
-      std::atomic_thread_fence(std::memory_order_acquire);
-      CF_ATTACH_NOTE("current:", m_suspended_handle->address());
-      CF_ATTACH_NOTE("next:", o.m_next.coro.address());
+      if (current.schedule == nullptr)
+      {
+        return false;
+      }
+      CF_ATTACH_NOTE("Inline resume budget is exhausted");
+      struct rest_t
+      {
+          continuation_data current;
+          std::vector<std::coroutine_handle<>> handles_to_destroy;
+      };
+      // continuation_data is move only, the callback needs to be copyable
+      auto rest = std::make_shared<rest_t>(
+          rest_t{ std::move(current), std::move(handles_to_destroy) });
+      auto& schedule = rest->current.schedule;
+      try
+      {
+        schedule(
+            [p_rest = rest]
+            {
+              continue_chain(std::move(p_rest->current),
+                             std::move(p_rest->handles_to_destroy),
+                             false);
+            });
+      }
+      catch (...)
+      {
+        current = std::move(rest->current);
+        handles_to_destroy = std::move(rest->handles_to_destroy);
+        return false;
+      }
+      return true;
+    }
 
-      auto suspended_data =
-          continuation_data::create_data(*reset_suspended_handle());
-      suspended_data.set_next(std::exchange(m_next, {}));
-      o.m_next = std::move(suspended_data);
+    // Same as reschedule_chain but for the suspended handle of this chain.
+    bool reschedule_continue()
+    {
+      CF_ATTACH_NOTE("Inline resume budget is exhausted");
+      try
+      {
+        m_suspended_handle.value().promise().context.schedule(
+            [this] { continue_suspended_handle(); });
+      }
+      catch (...)
+      {
+        return false;
+      }
+      return true;
     }
 
+  public:
     void store_suspended_handle(
         std::coroutine_handle<promise_type> suspended_handle) noexcept
     {
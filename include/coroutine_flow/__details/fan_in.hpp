@@ -0,0 +1,94 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Common state of the combinators that await several children at once
+ * (when_all, when_any). The children run detached, each of them reports its
+ * result into the slot that the combinator reserved for it in the same
+ * state. A single state is kept for all the children.
+ */
+class fan_in_state_t
+{
+  public:
+    fan_in_state_t(cancellable_suspend_t::resumer_t resumer,
+                   std::size_t child_count)
+        : m_resumer(std::move(resumer))
+        , m_remaining(child_count)
+    {
+    }
+
+    /**
+     * Returns true for the first child that reports (e.g. the first failure
+     * of when_all or the winner of when_any), its index and exception are
+     * kept.
+     */
+    bool try_claim_first(std::size_t index, std::exception_ptr exception)
+    {
+      if (m_first_finished.test_and_set(std::memory_order_acq_rel))
+      {
+        return false;
+      }
+      m_first_index = index;
+      m_exception = std::move(exception);
+      return true;
+    }
+    // The awaiting coroutine is resumed once, by the last child.
+    void arrive()
+    {
+      if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        m_resumer.resume();
+      }
+    }
+    // The awaiting coroutine is resumed by the child that claimed first.
+    void resume() const { m_resumer.resume(); }
+
+    const task_context_t& context() const { return m_resumer.context(); }
+    std::size_t first_index() const { return m_first_index; }
+    const std::exception_ptr& exception() const { return m_exception; }
+
+  private:
+    cancellable_suspend_t::resumer_t m_resumer;
+    std::atomic_size_t m_remaining;
+    std::atomic_flag m_first_finished;
+    std::size_t m_first_index{ 0 };
+    std::exception_ptr m_exception;
+};
+
+/**
+ * Awaits the child and stores its result into the slot, which is owned by
+ * the state. on_finished(state, index, exception) is called at the end.
+ * state_ptr_t is a shared_ptr when the children can outlive the awaiting
+ * coroutine (when_any), otherwise a plain pointer.
+ */
+template <typename T, typename state_ptr_t, typename on_finished_t>
+task<int> run_fan_in_child(task<T> child,
+                           state_ptr_t state,
+                           std::optional<T>* slot,
+                           std::size_t index,
+                           on_finished_t on_finished)
+{
+  std::exception_ptr exception;
+  try
+  {
+    slot->emplace(co_await std::move(child));
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+  on_finished(*state, index, std::move(exception));
+  co_return 0;
+}
+} // namespace coroutine_flow::__details
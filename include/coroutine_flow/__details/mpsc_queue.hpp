@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Lock-free, unbounded multi producer single consumer queue (intrusive list
+ * with a stub node, as described by Dmitry Vyukov). push is wait-free and can
+ * be called from any thread, try_pop must be called only by one thread at a
+ * time.
+ */
+template <typename T>
+class mpsc_queue_t
+{
+    struct node_t
+    {
+        std::atomic<node_t*> next{ nullptr };
+        std::optional<T> value;
+    };
+
+  public:
+    mpsc_queue_t()
+        : m_head(&m_stub)
+        , m_tail(&m_stub)
+    {
+    }
+    mpsc_queue_t(const mpsc_queue_t&) = delete;
+    mpsc_queue_t(mpsc_queue_t&&) = delete;
+
+    mpsc_queue_t& operator=(const mpsc_queue_t&) = delete;
+    mpsc_queue_t& operator=(mpsc_queue_t&&) = delete;
+
+    ~mpsc_queue_t()
+    {
+      while (try_pop().has_value())
+      {
+      }
+      if (m_tail != &m_stub)
+      {
+        delete m_tail;
+      }
+    }
+
+    void push(T value)
+    {
+      node_t* node = new node_t;
+      node->value.emplace(std::move(value));
+      push_node(node);
+    }
+    /**
+     * The nodes are linked first and published with one exchange, thus
+     * either every value is pushed or none of them (when it throws). The
+     * values are moved from.
+     */
+    template <typename range_t>
+    void push_bulk(range_t&& values)
+    {
+      node_t* first = nullptr;
+      node_t* last = nullptr;
+      try
+      {
+        for (auto& value : values)
+        {
+          node_t* node = new node_t;
+          node->value.emplace(std::move(value));
+          if (last == nullptr)
+          {
+            first = node;
+          }
+          else
+          {
+            last->next.store(node, std::memory_order_relaxed);
+          }
+          last = node;
+        }
+      }
+      catch (...)
+      {
+        while (first != nullptr)
+        {
+          delete std::exchange(first,
+                               first->next.load(std::memory_order_relaxed));
+        }
+        throw;
+      }
+      if (last == nullptr)
+      {
+        return;
+      }
+      node_t* previous = m_head.exchange(last, std::memory_order_acq_rel);
+      previous->next.store(first, std::memory_order_release);
+    }
+
+    /**
+     * Returns nullopt when the queue is empty. An item whose push is still in
+     * progress is not visible yet, it is treated as empty too.
+     */
+    std::optional<T> try_pop()
+    {
+      node_t* tail = m_tail;
+      node_t* next = tail->next.load(std::memory_order_acquire);
+      if (tail == &m_stub)
+      {
+        if (next == nullptr)
+        {
+          return std::nullopt;
+        }
+        // Skip the stub, it never holds a value
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+      }
+      if (next != nullptr)
+      {
+        return take(tail, next);
+      }
+      if (tail != m_head.load(std::memory_order_acquire))
+      {
+        // A producer is between the exchange and the link
+        return std::nullopt;
+      }
+      // tail is the last node, the stub is put behind it to be able to
+      // release it.
+      push_node(&m_stub);
+      next = tail->next.load(std::memory_order_acquire);
+      if (next == nullptr)
+      {
+        return std::nullopt;
+      }
+      return take(tail, next);
+    }
+
+    /**
+     * Pops an item that is known to be pushed (e.g. a counter tells so), but
+     * its push might be still in progress.
+     */
+    T pop_pushed()
+    {
+      while (true)
+      {
+        if (std::optional<T> value = try_pop())
+        {
+          return std::move(*value);
+        }
+        std::this_thread::yield();
+      }
+    }
+
+  private:
+    void push_node(node_t* node)
+    {
+      node->next.store(nullptr, std::memory_order_relaxed);
+      node_t* previous = m_head.exchange(node, std::memory_order_acq_rel);
+      previous->next.store(node, std::memory_order_release);
+    }
+
+    std::optional<T> take(node_t* tail, node_t* next)
+    {
+      m_tail = next;
+      std::optional<T> result = std::move(tail->value);
+      delete tail;
+      return result;
+    }
+
+    std::atomic<node_t*> m_head;
+    node_t* m_tail;
+    node_t m_stub;
+};
+} // namespace coroutine_flow::__details
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace coroutine_flow::__details
+{
+constexpr const std::size_t c_default_inline_resume_budget = 64;
+
+inline std::atomic<std::size_t>& inline_resume_budget() noexcept
+{
+  static std::atomic<std::size_t> value{ c_default_inline_resume_budget };
+  return value;
+}
+inline std::size_t& inline_resume_count() noexcept
+{
+  thread_local std::size_t value = 0;
+  return value;
+}
+/**
+ * Every scheduled callback starts with a full budget. The coroutine chain
+ * consumes it whenever it resumes a coroutine inline (i.e. without going
+ * through the scheduler). When the budget is exhausted the continuation is
+ * pushed back to the scheduler, thus a long chain of synchronously
+ * completing coroutines can't monopolize the worker.
+ */
+inline void reset_inline_resumes() noexcept { inline_resume_count() = 0; }
+inline bool try_consume_inline_resume() noexcept
+{
+  std::size_t& count = inline_resume_count();
+  if (count >= inline_resume_budget().load(std::memory_order_relaxed))
+  {
+    return false;
+  }
+  ++count;
+  return true;
+}
+} // namespace coroutine_flow::__details
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <coroutine>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Tells the resumer of a coroutine whether it finished during the resume.
+ * When the coroutine suspends instead, it might be continued, finished and
+ * destroyed by another thread before resume returns, thus its frame (e.g.
+ * done()) can't be checked afterwards. The final suspend of the coroutine
+ * marks the innermost scope of its thread, which belongs to its resumer.
+ */
+class resume_scope_t
+{
+  public:
+    explicit resume_scope_t(std::coroutine_handle<> coroutine) noexcept
+        : m_coroutine(coroutine.address())
+        , m_previous(std::exchange(current(), this))
+    {
+    }
+    resume_scope_t(const resume_scope_t&) = delete;
+    resume_scope_t& operator=(const resume_scope_t&) = delete;
+    ~resume_scope_t() { current() = m_previous; }
+
+    bool finished() const noexcept { return m_finished; }
+
+    // Called by the final_suspend of the promises
+    static void on_final_suspend(std::coroutine_handle<> coroutine) noexcept
+    {
+      resume_scope_t* scope = current();
+      if (scope != nullptr && scope->m_coroutine == coroutine.address())
+      {
+        scope->m_finished = true;
+      }
+    }
+
+  private:
+    static resume_scope_t*& current() noexcept
+    {
+      thread_local resume_scope_t* scope = nullptr;
+      return scope;
+    }
+
+    void* m_coroutine;
+    resume_scope_t* m_previous;
+    bool m_finished{ false };
+};
+
+// Resumes the coroutine, returns true when it's finished (but not destroyed)
+inline bool resume_and_check_done(std::coroutine_handle<> coroutine)
+{
+  resume_scope_t scope(coroutine);
+  coroutine.resume();
+  return scope.finished();
+}
+} // namespace coroutine_flow::__details
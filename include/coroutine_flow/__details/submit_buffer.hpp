@@ -0,0 +1,194 @@
+#pragma once
+
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Tasks that are scheduled while a coroutine is resumed (e.g. detached
+ * run_async calls) are collected per thread and handed over to their
+ * schedulers in batches (schedule_bulk_t) when the resume is finished. It
+ * saves queue synchronizations and worker wakeups.
+ *
+ * Only schedulers that accept batches and are referenced by pointer (thus
+ * they can be identified without allocation) are buffered.
+ */
+class submit_buffer_t
+{
+    using bulk_schedule_t = void (*)(const void*,
+                                     std::vector<std::function<void()>>,
+                                     const schedule_hints_t&);
+    struct batch_t
+    {
+        const void* scheduler;
+        bulk_schedule_t bulk_schedule;
+        schedule_hints_t hints;
+        std::vector<std::function<void()>> callbacks;
+    };
+
+  public:
+    static submit_buffer_t& instance() noexcept
+    {
+      thread_local submit_buffer_t buffer;
+      return buffer;
+    }
+
+    /**
+     * The tasks that are scheduled until the end of the scope are buffered.
+     * Every scope flushes the buffer when it ends, thus nested resumes (e.g.
+     * a worker helping its pool from a sync_wait) can't hold back the work.
+     *
+     * end() is called on the normal path, a refused batch is rethrown to the
+     * caller. The destructor ends the scope only when an exception is
+     * already propagating, then a refused batch can't be reported.
+     */
+    class scope_t
+    {
+      public:
+        scope_t() noexcept { ++instance().m_scope_depth; }
+        scope_t(const scope_t&) = delete;
+        scope_t& operator=(const scope_t&) = delete;
+        ~scope_t()
+        {
+          if (m_ended)
+          {
+            return;
+          }
+          try
+          {
+            end();
+          }
+          catch (...)
+          {
+            // The original exception is propagated instead
+          }
+        }
+
+        void end()
+        {
+          m_ended = true;
+          submit_buffer_t& buffer = instance();
+          --buffer.m_scope_depth;
+          buffer.flush();
+        }
+
+      private:
+        bool m_ended{ false };
+    };
+
+    template <typename scheduler_t>
+    static constexpr bool is_bufferable =
+        std::is_pointer_v<scheduler_t> && bulk_scheduler<scheduler_t>;
+
+    // Returns false when the task is not buffered (no scope is active).
+    template <task_scheduler scheduler_t>
+      requires is_bufferable<scheduler_t>
+    bool try_push(scheduler_t scheduler,
+                  std::function<void()>& callback,
+                  const schedule_hints_t& hints)
+    {
+      if (m_scope_depth == 0)
+      {
+        return false;
+      }
+      const void* address = static_cast<const void*>(scheduler);
+      // A resume schedules to a few schedulers, the last batch is the usual
+      // match.
+      auto batch = std::find_if(m_batches.rbegin(),
+                                m_batches.rend(),
+                                [&](const batch_t& batch)
+                                {
+                                  return batch.scheduler == address &&
+                                         batch.bulk_schedule ==
+                                             &bulk_schedule<scheduler_t> &&
+                                         batch.hints == hints;
+                                });
+      if (batch == m_batches.rend())
+      {
+        m_batches.push_back(
+            { address, &bulk_schedule<scheduler_t>, hints, {} });
+        batch = m_batches.rbegin();
+      }
+      batch->callbacks.push_back(std::move(callback));
+      return true;
+    }
+
+    /**
+     * Hands the buffered batches over to their schedulers. A refused batch
+     * doesn't hold back the others, the first exception is rethrown at the
+     * end. It's called before the library blocks a thread that might hold
+     * buffered tasks (e.g. sync_wait).
+     */
+    void flush()
+    {
+      if (m_batches.empty())
+      {
+        return;
+      }
+      CF_PROFILE_SCOPE();
+      // Scheduling might execute tasks inline that buffer new ones
+      std::vector<batch_t> batches = std::exchange(m_batches, {});
+      std::exception_ptr exception;
+      for (batch_t& batch : batches)
+      {
+        try
+        {
+          batch.bulk_schedule(
+              batch.scheduler, std::move(batch.callbacks), batch.hints);
+        }
+        catch (...)
+        {
+          if (exception == nullptr)
+          {
+            exception = std::current_exception();
+          }
+        }
+      }
+      if (exception != nullptr)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+
+  private:
+    template <typename scheduler_t>
+    static void bulk_schedule(const void* scheduler,
+                              std::vector<std::function<void()>> callbacks,
+                              const schedule_hints_t& hints)
+    {
+      using pointee_t = std::remove_pointer_t<scheduler_t>;
+      tag_invoke(schedule_bulk_t{},
+                 const_cast<scheduler_t>(static_cast<const pointee_t*>(
+                     scheduler)),
+                 std::move(callbacks),
+                 hints);
+    }
+
+    std::vector<batch_t> m_batches;
+    std::size_t m_scope_depth{ 0 };
+};
+
+// Schedules the callback, or buffers it when it's scheduled during a resume.
+template <task_scheduler scheduler_t>
+void submit_task(const scheduler_t& scheduler,
+                 std::function<void()> callback,
+                 const schedule_hints_t& hints)
+{
+  if constexpr (submit_buffer_t::is_bufferable<scheduler_t>)
+  {
+    if (submit_buffer_t::instance().try_push(scheduler, callback, hints))
+    {
+      return;
+    }
+  }
+  schedule_task(scheduler, std::move(callback), hints);
+}
+} // namespace coroutine_flow::__details
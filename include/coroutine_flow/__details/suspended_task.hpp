@@ -0,0 +1,91 @@
+#pragma once
+
+#include <coroutine_flow/__details/resume_budget.hpp>
+#include <coroutine_flow/__details/submit_buffer.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <concepts>
+#include <functional>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * A task that is suspended by a library awaitable (e.g. blocking). The
+ * awaitable resumes it once, when the awaited operation is finished. After
+ * resume the task (and the awaitable itself, which lives in the frame of the
+ * task) might be already destroyed.
+ */
+class suspended_task_t
+{
+  public:
+    /**
+     * task_context is the context of the suspended coroutine, it is copied
+     * because the coroutine might be destroyed before resume returns.
+     */
+    suspended_task_t(task_context_t& task_context,
+                     std::function<void()> continuation)
+        : m_context(task_context)
+        , m_task_context(&task_context)
+        , m_continuation(std::move(continuation))
+    {
+    }
+
+    // Continues the task on the scheduler where it was running.
+    void resume()
+    {
+      // The context is moved out, this object might be destroyed by the
+      // continuation before schedule returns.
+      task_context_t context = std::move(m_context);
+      context.schedule(std::move(m_continuation));
+    }
+    /**
+     * Continues the task on another scheduler. The task and every coroutine
+     * that it co_awaits afterwards use that scheduler.
+     */
+    template <task_scheduler scheduler_t>
+    void resume_on(const scheduler_t& scheduler)
+    {
+      // The task is suspended, nobody reads its context concurrently.
+      m_task_context->set_scheduler(scheduler);
+      m_task_context->hopped = true;
+      m_context.set_scheduler(scheduler);
+      resume();
+    }
+    /**
+     * Continues the task on the current thread. It is never pushed back to
+     * the scheduler, the caller acts as a newly scheduled task.
+     */
+    void resume_inline()
+    {
+      reset_inline_resumes();
+      submit_buffer_t::scope_t submit_scope;
+      auto continuation = std::move(m_continuation);
+      continuation();
+      submit_scope.end();
+    }
+
+    const task_context_t& context() const { return m_context; }
+    const schedule_hints_t& hints() const { return m_context.hints; }
+
+  private:
+    task_context_t m_context;
+    task_context_t* m_task_context;
+    std::function<void()> m_continuation;
+};
+
+/**
+ * Awaitables of the library that suspend a task without co_awaiting another
+ * task. Instead of the coroutine handle they receive the suspended task.
+ * await_suspend can return bool: false means that the task was not handed
+ * over and it continues immediately.
+ */
+template <typename awaitable_t>
+concept library_awaitable =
+    requires(awaitable_t awaitable, suspended_task_t suspended_task) {
+      { awaitable.await_ready() } -> std::convertible_to<bool>;
+      { awaitable.await_suspend(std::move(suspended_task)) };
+      { awaitable.await_resume() };
+    };
+} // namespace coroutine_flow::__details
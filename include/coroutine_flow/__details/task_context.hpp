@@ -0,0 +1,132 @@
+#pragma once
+
+#include <coroutine_flow/__details/resume_budget.hpp>
+#include <coroutine_flow/__details/submit_buffer.hpp>
+#include <coroutine_flow/__details/timer_service.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <stop_token>
+
+namespace coroutine_flow::__details
+{
+using schedule_callback_t =
+    std::function<void(std::function<void()>, const schedule_hints_t&)>;
+// Returns the id of the timer when the timer thread of the library is used
+using schedule_at_callback_t =
+    std::function<std::optional<timer_id_t>(std::function<void()>,
+                                             timer_clock_t::time_point,
+                                             const schedule_hints_t&)>;
+
+/**
+ * Everything a coroutine inherits from the one that co_awaits it. It is
+ * created by run_async/sync_wait for the top level coroutine and copied into
+ * every child by run_async_impl.
+ */
+struct task_context_t
+{
+    schedule_callback_t schedule_callback;
+    schedule_at_callback_t schedule_at_callback;
+    schedule_hints_t hints;
+    // Stop request of the coroutine tree
+    std::stop_token stop_token;
+    /**
+     * The coroutine moved to another scheduler (continue_on). Its awaiting
+     * coroutine is not continued inline when it's finished but scheduled on
+     * its own scheduler. It's not inherited.
+     */
+    bool hopped{ false };
+
+    void schedule(std::function<void()> callback) const
+    {
+      schedule_callback(std::move(callback), hints);
+    }
+    /**
+     * The returned timer of the library can be cancelled with
+     * timer_service_t::cancel. Native timers of the scheduler can't be, their
+     * callbacks have to tolerate a late call.
+     */
+    std::optional<timer_id_t>
+        schedule_at(std::function<void()> callback,
+                    timer_clock_t::time_point expiry) const
+    {
+      return schedule_at_callback(std::move(callback), expiry, hints);
+    }
+
+    template <task_scheduler scheduler_t>
+    void set_scheduler(const scheduler_t& scheduler);
+};
+
+// co_await-ed by cf::get_stop_token(), the promise answers it from the context
+struct get_stop_token_t
+{
+};
+
+/**
+ * Every callback that is scheduled by a coroutine starts with a full inline
+ * resume budget and the tasks that it schedules are submitted together when
+ * it returns. The wrapped start callbacks remain sheddable.
+ */
+template <typename callback_t>
+std::function<void()> make_resume_callback(callback_t callback)
+{
+  bool* shed_requested = nullptr;
+  if constexpr (std::same_as<callback_t, start_callback_t>)
+  {
+    shed_requested = callback.shed_requested;
+  }
+  else if constexpr (std::same_as<callback_t, std::function<void()>>)
+  {
+    if (auto* start = callback.template target<start_callback_t>())
+    {
+      shed_requested = start->shed_requested;
+    }
+  }
+  auto resume = [p_callback = std::move(callback)]()
+  {
+    reset_inline_resumes();
+    submit_buffer_t::scope_t submit_scope;
+    p_callback();
+    submit_scope.end();
+  };
+  if (shed_requested != nullptr)
+  {
+    return start_callback_t{ std::move(resume), shed_requested };
+  }
+  return resume;
+}
+
+template <task_scheduler scheduler_t>
+schedule_callback_t make_schedule_callback(scheduler_t scheduler)
+{
+  return [p_scheduler = std::move(scheduler)](std::function<void()> handle,
+                                              const schedule_hints_t& hints)
+  {
+    submit_task(p_scheduler, make_resume_callback(std::move(handle)), hints);
+  };
+}
+
+template <task_scheduler scheduler_t>
+schedule_at_callback_t make_schedule_at_callback(scheduler_t scheduler)
+{
+  return [p_scheduler = std::move(scheduler)](
+             std::function<void()> handle,
+             timer_clock_t::time_point expiry,
+             const schedule_hints_t& hints)
+  {
+    return schedule_task_at(p_scheduler,
+                            make_resume_callback(std::move(handle)),
+                            expiry,
+                            hints);
+  };
+}
+
+template <task_scheduler scheduler_t>
+void task_context_t::set_scheduler(const scheduler_t& scheduler)
+{
+  schedule_callback = make_schedule_callback(scheduler);
+  schedule_at_callback = make_schedule_at_callback(scheduler);
+}
+} // namespace coroutine_flow::__details
@@ -13,18 +13,17 @@ enum class test_injection_points_t
 {
   task__constructor,
   task__await_ready__begin,
-  task__await_ready__after_test_and_set,
 
-  task__await_suspend__after_test_and_set,
+  task__await_suspend__async_call_scheduled,
 
   task__run_async__async_call_finished,
-  task__run_async__before_test_and_set,
 
   task__run_async__after_resume_suspended,
   task__run_async__after_released_suspended,
 
+  task__continue_chain__after_resume,
+
   task__sync_wait__has_result,
-  task__sync_wait__handle_destroy,
 
   object__construct,
   object__destruct
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <coroutine_flow/__details/timer_wheel.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Timer thread of the library for the schedulers that don't have their own
+ * timers. The timers are kept in a timer_wheel_t. The expired callbacks are
+ * executed on the timer thread, thus they should only hand over the work to
+ * a scheduler. Timers that are still pending when the service is destroyed
+ * (at exit) are dropped.
+ */
+class timer_service_t
+{
+  public:
+    static timer_service_t& instance()
+    {
+      static timer_service_t service;
+      return service;
+    }
+
+    timer_service_t(const timer_service_t&) = delete;
+    timer_service_t(timer_service_t&&) = delete;
+
+    timer_service_t& operator=(const timer_service_t&) = delete;
+    timer_service_t& operator=(timer_service_t&&) = delete;
+
+    ~timer_service_t()
+    {
+      m_thread.request_stop();
+      m_condition.notify_all();
+    }
+
+    timer_id_t schedule_at(timer_clock_t::time_point expiry,
+                           std::function<void()> callback)
+    {
+      timer_id_t id;
+      bool earlier = false;
+      {
+        std::lock_guard lock(m_mutex);
+        id = m_wheel.schedule_at(expiry, std::move(callback));
+        earlier = expiry < m_wake_up;
+        if (earlier)
+        {
+          m_wake_up = expiry;
+        }
+      }
+      // The thread sleeps until the next expiry that it knows about
+      if (earlier)
+      {
+        m_condition.notify_one();
+      }
+      return id;
+    }
+    // Returns false when the timer already expired or it was cancelled.
+    bool cancel(timer_id_t id)
+    {
+      std::lock_guard lock(m_mutex);
+      return m_wheel.cancel(id);
+    }
+
+  private:
+    timer_service_t()
+        : m_thread([this](std::stop_token stop_token) { run(stop_token); })
+    {
+    }
+
+    void run(std::stop_token stop_token)
+    {
+      std::vector<std::function<void()>> expired;
+      std::unique_lock lock(m_mutex);
+      while (stop_token.stop_requested() == false)
+      {
+        m_wheel.advance(timer_clock_t::now(), expired);
+        if (expired.empty() == false)
+        {
+          lock.unlock();
+          for (auto& callback : expired)
+          {
+            CF_PROFILE_SCOPE_N("timer_service_t::expire");
+            callback();
+          }
+          expired.clear();
+          lock.lock();
+          continue;
+        }
+        const auto wake_up =
+            m_wheel.next_wake_up().value_or(timer_clock_t::time_point::max());
+        m_wake_up = wake_up;
+        if (wake_up == timer_clock_t::time_point::max())
+        {
+          m_condition.wait(lock,
+                           stop_token,
+                           [&] { return m_wake_up != wake_up; });
+        }
+        else
+        {
+          m_condition.wait_until(lock,
+                                 stop_token,
+                                 wake_up,
+                                 [&] { return m_wake_up != wake_up; });
+        }
+      }
+    }
+
+    timer_wheel_t m_wheel;
+    // The time point until the thread sleeps
+    timer_clock_t::time_point m_wake_up{ timer_clock_t::time_point::max() };
+    std::mutex m_mutex;
+    std::condition_variable_any m_condition;
+    std::jthread m_thread;
+};
+
+/**
+ * Schedules the callback when the time point is reached. The native timers of
+ * the scheduler are used when it has them (schedule_at_t/schedule_after_t),
+ * otherwise the timer thread of the library hands over the callback. Only
+ * the timers of the library can be cancelled, their id is returned.
+ */
+template <task_scheduler scheduler_t>
+std::optional<timer_id_t>
+    schedule_task_at(const scheduler_t& scheduler,
+                     std::function<void()> callback,
+                     timer_clock_t::time_point expiry,
+                     const schedule_hints_t& hints)
+{
+  if constexpr (schedule_at_scheduler<scheduler_t>)
+  {
+    tag_invoke(schedule_at_t{}, scheduler, std::move(callback), expiry, hints);
+    return std::nullopt;
+  }
+  else if constexpr (schedule_after_scheduler<scheduler_t>)
+  {
+    tag_invoke(schedule_after_t{},
+               scheduler,
+               std::move(callback),
+               std::max(expiry - timer_clock_t::now(),
+                        timer_clock_t::duration::zero()),
+               hints);
+    return std::nullopt;
+  }
+  else
+  {
+    return timer_service_t::instance().schedule_at(
+        expiry,
+        [p_scheduler = scheduler,
+         p_callback = std::move(callback),
+         p_hints = hints]() mutable
+        { schedule_task(p_scheduler, std::move(p_callback), p_hints); });
+  }
+}
+} // namespace coroutine_flow::__details
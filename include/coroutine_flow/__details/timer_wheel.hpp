@@ -0,0 +1,335 @@
+#pragma once
+
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow::__details
+{
+// Identifies a timer of a timer_wheel_t, it can be used to cancel the timer
+struct timer_id_t
+{
+    std::uint32_t index{ 0 };
+    std::uint32_t generation{ 0 };
+
+    bool operator==(const timer_id_t&) const = default;
+};
+
+/**
+ * Hashed hierarchical timer wheel. Scheduling and cancelling a timer is O(1),
+ * advancing the wheel is O(1) per tick plus the expired (and cascaded)
+ * timers. Timers never expire early, they expire at most one tick late.
+ *
+ * It's not thread safe and it has no thread: the owner drives it with
+ * advance (e.g. the timer thread of the library or the tick of an event
+ * loop). The timers are stored in a slab, thus the wheel doesn't allocate
+ * per timer once the slab is big enough.
+ */
+class timer_wheel_t
+{
+    static constexpr std::size_t c_slot_bits = 8;
+    static constexpr std::size_t c_slot_count = std::size_t{ 1 }
+                                                << c_slot_bits;
+    static constexpr std::uint64_t c_slot_mask = c_slot_count - 1;
+    // With 1ms ticks the wheel covers ~49 days, later timers are cascaded
+    // from the last level until they fit.
+    static constexpr std::size_t c_level_count = 4;
+    static constexpr std::uint32_t c_null = UINT32_MAX;
+
+    struct node_t
+    {
+        std::uint64_t expiry_tick{ 0 };
+        std::function<void()> callback;
+        std::uint32_t previous{ c_null };
+        std::uint32_t next{ c_null };
+        // Slot list of the timer, c_null when it's free
+        std::uint32_t slot{ c_null };
+        std::uint32_t generation{ 0 };
+    };
+
+  public:
+    using clock_t = timer_clock_t;
+    static constexpr clock_t::duration c_default_resolution =
+        std::chrono::milliseconds(1);
+
+    explicit timer_wheel_t(
+        clock_t::time_point origin = clock_t::now(),
+        clock_t::duration resolution = c_default_resolution)
+        : m_origin(origin)
+        , m_resolution(resolution)
+    {
+      m_slots.fill(c_null);
+      m_slot_tails.fill(c_null);
+    }
+
+    timer_id_t schedule_at(clock_t::time_point expiry,
+                           std::function<void()> callback)
+    {
+      const std::uint32_t index = allocate_node();
+      node_t& node = m_nodes[index];
+      // Rounded up, the timer must not expire early. Expired timers fire at
+      // the next tick.
+      node.expiry_tick = std::max(to_tick_ceil(expiry), m_current_tick + 1);
+      node.callback = std::move(callback);
+      link_back(index);
+      ++m_size;
+      return { index, node.generation };
+    }
+
+    // Returns false when the timer already expired or it was cancelled.
+    bool cancel(timer_id_t id)
+    {
+      if (id.index >= m_nodes.size() ||
+          m_nodes[id.index].generation != id.generation ||
+          m_nodes[id.index].slot == c_null)
+      {
+        return false;
+      }
+      unlink(id.index);
+      free_node(id.index);
+      --m_size;
+      return true;
+    }
+
+    /**
+     * Moves the wheel to now. The callbacks of the expired timers are
+     * appended to expired in the order of their expiry; they are not
+     * executed, thus the owner can run them outside of its lock.
+     */
+    void advance(clock_t::time_point now,
+                 std::vector<std::function<void()>>& expired)
+    {
+      CF_PROFILE_SCOPE();
+      const std::uint64_t target_tick = to_tick_floor(now);
+      while (m_current_tick < target_tick)
+      {
+        if (m_size == 0)
+        {
+          m_current_tick = target_tick;
+          return;
+        }
+        ++m_current_tick;
+        cascade();
+        expire_slot(slot_of(0, m_current_tick), expired);
+      }
+    }
+
+    /**
+     * Time point until the owner can sleep without missing a timer. It's
+     * the expiry of the next timer when it's in the lowest level, otherwise
+     * the next cascade. Empty when there is no timer.
+     */
+    std::optional<clock_t::time_point> next_wake_up() const
+    {
+      if (m_size == 0)
+      {
+        return std::nullopt;
+      }
+      std::uint64_t tick = m_current_tick + 1;
+      for (; tick % c_slot_count != 0; ++tick)
+      {
+        if (m_slots[slot_of(0, tick)] != c_null)
+        {
+          break;
+        }
+      }
+      return m_origin + m_resolution * static_cast<clock_t::rep>(tick);
+    }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+  private:
+    static std::uint32_t slot_of(std::size_t level, std::uint64_t tick)
+    {
+      return static_cast<std::uint32_t>(
+          level * c_slot_count +
+          ((tick >> (level * c_slot_bits)) & c_slot_mask));
+    }
+
+    std::uint64_t to_tick_floor(clock_t::time_point time) const
+    {
+      if (time <= m_origin)
+      {
+        return 0;
+      }
+      return static_cast<std::uint64_t>((time - m_origin) / m_resolution);
+    }
+    std::uint64_t to_tick_ceil(clock_t::time_point time) const
+    {
+      if (time <= m_origin)
+      {
+        return 0;
+      }
+      if (time == clock_t::time_point::max())
+      {
+        return UINT64_MAX;
+      }
+      const auto elapsed = time - m_origin;
+      const auto ticks =
+          static_cast<std::uint64_t>(elapsed / m_resolution);
+      return elapsed % m_resolution == clock_t::duration::zero() ? ticks
+                                                                  : ticks + 1;
+    }
+
+    // Level where the timer waits, it's the last level when it's too far
+    std::uint32_t slot_for(std::uint64_t expiry_tick) const
+    {
+      const std::uint64_t delta = expiry_tick - m_current_tick;
+      for (std::size_t level = 0; level + 1 < c_level_count; ++level)
+      {
+        if (delta < (std::uint64_t{ 1 } << ((level + 1) * c_slot_bits)))
+        {
+          return slot_of(level, expiry_tick);
+        }
+      }
+      constexpr std::size_t c_last_level = c_level_count - 1;
+      constexpr std::uint64_t c_max_delta =
+          (std::uint64_t{ 1 } << (c_level_count * c_slot_bits)) - 1;
+      return slot_of(c_last_level,
+                     m_current_tick + std::min(delta, c_max_delta));
+    }
+
+    /**
+     * Timers of the higher levels move down when the lower level wraps. They
+     * were scheduled before the timers that are already in the lower slots
+     * with the same expiry, thus they go in front of them, in their order.
+     */
+    void cascade()
+    {
+      for (std::size_t level = 1; level < c_level_count; ++level)
+      {
+        if (((m_current_tick >> ((level - 1) * c_slot_bits)) & c_slot_mask) !=
+            0)
+        {
+          return;
+        }
+        const std::uint32_t slot = slot_of(level, m_current_tick);
+        m_slots[slot] = c_null;
+        std::uint32_t index = std::exchange(m_slot_tails[slot], c_null);
+        while (index != c_null)
+        {
+          const std::uint32_t previous = m_nodes[index].previous;
+          link_front(index);
+          index = previous;
+        }
+      }
+    }
+
+    void expire_slot(std::uint32_t slot,
+                     std::vector<std::function<void()>>& expired)
+    {
+      m_slot_tails[slot] = c_null;
+      std::uint32_t index = std::exchange(m_slots[slot], c_null);
+      while (index != c_null)
+      {
+        const std::uint32_t next = m_nodes[index].next;
+        expired.push_back(std::move(m_nodes[index].callback));
+        free_node(index);
+        --m_size;
+        index = next;
+      }
+    }
+
+    // The timers of a slot are kept in the order they were scheduled
+    void link_back(std::uint32_t index)
+    {
+      node_t& node = m_nodes[index];
+      node.slot = slot_for(node.expiry_tick);
+      node.next = c_null;
+      node.previous = m_slot_tails[node.slot];
+      if (node.previous != c_null)
+      {
+        m_nodes[node.previous].next = index;
+      }
+      else
+      {
+        m_slots[node.slot] = index;
+      }
+      m_slot_tails[node.slot] = index;
+    }
+    void link_front(std::uint32_t index)
+    {
+      node_t& node = m_nodes[index];
+      node.slot = slot_for(node.expiry_tick);
+      node.previous = c_null;
+      node.next = m_slots[node.slot];
+      if (node.next != c_null)
+      {
+        m_nodes[node.next].previous = index;
+      }
+      else
+      {
+        m_slot_tails[node.slot] = index;
+      }
+      m_slots[node.slot] = index;
+    }
+    void unlink(std::uint32_t index)
+    {
+      node_t& node = m_nodes[index];
+      if (node.previous != c_null)
+      {
+        m_nodes[node.previous].next = node.next;
+      }
+      else
+      {
+        m_slots[node.slot] = node.next;
+      }
+      if (node.next != c_null)
+      {
+        m_nodes[node.next].previous = node.previous;
+      }
+      else
+      {
+        m_slot_tails[node.slot] = node.previous;
+      }
+    }
+
+    std::uint32_t allocate_node()
+    {
+      if (m_free_head == c_null)
+      {
+        m_nodes.emplace_back();
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+      }
+      const std::uint32_t index = m_free_head;
+      m_free_head = m_nodes[index].next;
+      return index;
+    }
+    void free_node(std::uint32_t index)
+    {
+      node_t& node = m_nodes[index];
+      node.callback = nullptr;
+      node.slot = c_null;
+      // Invalidates the ids of the timer
+      ++node.generation;
+      node.next = m_free_head;
+      m_free_head = index;
+    }
+
+    clock_t::time_point m_origin;
+    clock_t::duration m_resolution;
+    std::uint64_t m_current_tick{ 0 };
+    std::size_t m_size{ 0 };
+    // Heads and tails of the slot lists
+    std::array<std::uint32_t, c_slot_count * c_level_count> m_slots;
+    std::array<std::uint32_t, c_slot_count * c_level_count> m_slot_tails;
+    std::vector<node_t> m_nodes;
+    std::uint32_t m_free_head{ c_null };
+};
+} // namespace coroutine_flow::__details
+
+namespace coroutine_flow
+{
+// Custom schedulers can drive it from their own tick
+using timer_wheel = __details::timer_wheel_t;
+} // namespace coroutine_flow
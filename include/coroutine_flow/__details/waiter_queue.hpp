@@ -0,0 +1,196 @@
+#pragma once
+
+#include <coroutine_flow/__details/submit_buffer.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace coroutine_flow::__details
+{
+/**
+ * Node of a waiter_queue_t. The awaitables of the synchronization primitives
+ * derive from it, they live in the frame of the suspended coroutine, thus
+ * waiting doesn't allocate.
+ *
+ * A stop request of the waiting task unlinks the node and resumes it, its
+ * await_resume throws operation_cancelled_error:
+ *
+ * - await_suspend calls enable_cancellation before it takes the lock of the
+ *   primitive, the cancel function takes that lock;
+ * - under the lock it doesn't suspend when cancelled() and sets the state to
+ *   finished or waiting;
+ * - the cancel function calls waiter_queue_t::cancel under the lock and
+ *   resumes the waiter after it released the lock;
+ * - await_resume calls finish_waiting.
+ */
+struct waiter_node_t
+{
+    enum class state_t
+    {
+      // The stop request came before await_suspend decided
+      pending,
+      waiting,
+      // Acquired without waiting
+      finished,
+      cancelled
+    };
+    using cancel_t = void (*)(waiter_node_t&);
+    struct stop_handler_t
+    {
+        waiter_node_t* waiter;
+        cancel_t cancel;
+
+        void operator()() const { cancel(*waiter); }
+    };
+
+    waiter_node_t() = default;
+    // The awaitables are moved only before they are awaited, there's no stop
+    // callback to move.
+    waiter_node_t(waiter_node_t&& other) noexcept
+        : suspended_task(std::move(other.suspended_task))
+    {
+    }
+
+    waiter_node_t* next{ nullptr };
+    std::optional<suspended_task_t> suspended_task;
+    // Guarded by the lock of the primitive
+    state_t state{ state_t::pending };
+    std::optional<std::stop_callback<stop_handler_t>> stop_callback;
+
+    // Continues the waiter on its scheduler. The node can't be used after.
+    void resume() { std::exchange(suspended_task, std::nullopt)->resume(); }
+    // The cancel function runs immediately when stop is already requested
+    void enable_cancellation(const std::stop_token& stop_token,
+                             cancel_t cancel)
+    {
+      if (stop_token.stop_possible())
+      {
+        stop_callback.emplace(stop_token, stop_handler_t{ this, cancel });
+      }
+    }
+    bool cancelled() const { return state == state_t::cancelled; }
+    // Called by await_resume
+    void finish_waiting()
+    {
+      // Waits for a concurrently running cancel function
+      stop_callback.reset();
+      if (cancelled())
+      {
+        throw operation_cancelled_error{};
+      }
+    }
+};
+
+/**
+ * Intrusive FIFO list of waiters. It's not synchronized, the primitives
+ * guard it with their lock and resume the waiters after they released it.
+ */
+class waiter_queue_t
+{
+  public:
+    waiter_queue_t() = default;
+    waiter_queue_t(waiter_queue_t&& other) noexcept
+        : m_head(std::exchange(other.m_head, nullptr))
+        , m_tail(std::exchange(other.m_tail, nullptr))
+    {
+    }
+    waiter_queue_t& operator=(waiter_queue_t&& other) noexcept
+    {
+      m_head = std::exchange(other.m_head, nullptr);
+      m_tail = std::exchange(other.m_tail, nullptr);
+      return *this;
+    }
+
+    bool empty() const { return m_head == nullptr; }
+    waiter_node_t* front() const { return m_head; }
+    void push_back(waiter_node_t* waiter)
+    {
+      waiter->next = nullptr;
+      if (m_tail == nullptr)
+      {
+        m_head = waiter;
+      }
+      else
+      {
+        m_tail->next = waiter;
+      }
+      m_tail = waiter;
+    }
+    waiter_node_t* pop_front()
+    {
+      waiter_node_t* waiter = m_head;
+      m_head = waiter->next;
+      if (m_head == nullptr)
+      {
+        m_tail = nullptr;
+      }
+      return waiter;
+    }
+    /**
+     * Called by the cancel function of a waiter under the lock of the
+     * primitive. Returns whether the waiter was unlinked, then the caller
+     * resumes it after releasing the lock. A waiter that was already handed
+     * over isn't cancelled.
+     */
+    bool cancel(waiter_node_t* waiter)
+    {
+      using state_t = waiter_node_t::state_t;
+      if (waiter->state == state_t::pending)
+      {
+        waiter->state = state_t::cancelled;
+        return false;
+      }
+      if (waiter->state != state_t::waiting || remove(waiter) == false)
+      {
+        return false;
+      }
+      waiter->state = state_t::cancelled;
+      return true;
+    }
+    /**
+     * Resumes every waiter in arrival order and empties the queue. The
+     * waiters of the same scheduler are handed over to it in one batch.
+     */
+    void resume_all()
+    {
+      submit_buffer_t::scope_t submit_scope;
+      waiter_node_t* waiter = std::exchange(m_head, nullptr);
+      m_tail = nullptr;
+      while (waiter != nullptr)
+      {
+        // The waiter might be destroyed as soon as it's resumed
+        waiter_node_t* next = waiter->next;
+        waiter->resume();
+        waiter = next;
+      }
+      submit_scope.end();
+    }
+
+  private:
+    bool remove(waiter_node_t* waiter)
+    {
+      waiter_node_t* previous = nullptr;
+      for (waiter_node_t* it = m_head; it != nullptr; it = it->next)
+      {
+        if (it != waiter)
+        {
+          previous = it;
+          continue;
+        }
+        (previous == nullptr ? m_head : previous->next) = it->next;
+        if (m_tail == it)
+        {
+          m_tail = previous;
+        }
+        return true;
+      }
+      return false;
+    }
+
+    waiter_node_t* m_head{ nullptr };
+    waiter_node_t* m_tail{ nullptr };
+};
+} // namespace coroutine_flow::__details
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace coroutine_flow::__details
+{
+using worker_clock_t = std::chrono::steady_clock;
+
+/**
+ * The ordering policy of a worker_pool_t. The queue is always accessed under
+ * the lock of the pool, so it doesn't need to be thread safe. push_bulk moves
+ * either every callback into the queue or none of them (when it throws).
+ */
+template <typename queue_t>
+concept worker_queue = requires(queue_t queue,
+                                std::function<void()> callback,
+                                std::vector<std::function<void()>> callbacks,
+                                const schedule_hints_t& hints,
+                                worker_clock_t::time_point now) {
+  { queue.push(std::move(callback), hints, now) };
+  { queue.push_bulk(callbacks, hints, now) };
+  {
+    queue.pop(now)
+  } -> std::same_as<std::optional<std::function<void()>>>;
+  { queue.empty() } -> std::convertible_to<bool>;
+};
+
+/**
+ * Fixed size thread pool where the order of the execution is defined by the
+ * queue policy. The queued tasks might continue suspended coroutines, thus
+ * the destruction of the pool waits until the workers drained the queue,
+ * including the tasks that are queued meanwhile.
+ */
+template <worker_queue queue_t>
+class worker_pool_t
+{
+  public:
+    template <typename... queue_args_t>
+    explicit worker_pool_t(std::size_t thread_count,
+                           queue_args_t&&... queue_args)
+        : m_queue(std::forward<queue_args_t>(queue_args)...)
+    {
+      m_workers.reserve(thread_count);
+      for (std::size_t i = 0; i < thread_count; ++i)
+      {
+        m_workers.emplace_back([this](std::stop_token stop_token)
+                               { worker_loop(stop_token); });
+      }
+    }
+    worker_pool_t(const worker_pool_t&) = delete;
+    worker_pool_t(worker_pool_t&&) = delete;
+
+    worker_pool_t& operator=(const worker_pool_t&) = delete;
+    worker_pool_t& operator=(worker_pool_t&&) = delete;
+
+    ~worker_pool_t()
+    {
+      for (auto& worker : m_workers)
+      {
+        worker.request_stop();
+      }
+      m_queue_condition.notify_all();
+      m_workers.clear();
+    }
+
+    void push(std::function<void()> callback, const schedule_hints_t& hints)
+    {
+      {
+        std::lock_guard lock(m_queue_mutex);
+        m_queue.push(std::move(callback), hints, worker_clock_t::now());
+      }
+      m_queue_condition.notify_one();
+    }
+    void push_bulk(std::vector<std::function<void()>> callbacks,
+                   const schedule_hints_t& hints)
+    {
+      {
+        std::lock_guard lock(m_queue_mutex);
+        m_queue.push_bulk(callbacks, hints, worker_clock_t::now());
+      }
+      notify_workers(callbacks.size());
+    }
+
+    std::size_t thread_count() const { return m_workers.size(); }
+
+    /**
+     * Executes a queued task on the calling thread when it is a worker of
+     * this pool (see run_pending_task_t).
+     */
+    bool run_pending(std::stop_token ready)
+    {
+      if (current_worker_owner() != this)
+      {
+        return false;
+      }
+      std::unique_lock lock(m_queue_mutex);
+      if (m_queue_condition.wait(lock,
+                                 ready,
+                                 [&] { return m_queue.empty() == false; }))
+      {
+        execute_next(lock);
+      }
+      return true;
+    }
+
+    /**
+     * Gives access to the queue for statistics and configuration. The
+     * callback is called while the queue is locked.
+     */
+    template <typename callback_t>
+    decltype(auto) with_queue(callback_t&& callback) const
+    {
+      std::lock_guard lock(m_queue_mutex);
+      return std::forward<callback_t>(callback)(m_queue);
+    }
+    template <typename callback_t>
+    decltype(auto) with_queue(callback_t&& callback)
+    {
+      std::lock_guard lock(m_queue_mutex);
+      return std::forward<callback_t>(callback)(m_queue);
+    }
+
+  private:
+    void notify_workers(std::size_t task_count)
+    {
+      if (task_count >= m_workers.size())
+      {
+        m_queue_condition.notify_all();
+        return;
+      }
+      for (std::size_t i = 0; i < task_count; ++i)
+      {
+        m_queue_condition.notify_one();
+      }
+    }
+
+    void worker_loop(std::stop_token stop_token)
+    {
+      current_worker_owner() = this;
+      std::unique_lock lock(m_queue_mutex);
+      while (true)
+      {
+        m_queue_condition.wait(lock,
+                               stop_token,
+                               [&] { return m_queue.empty() == false; });
+        // The queue is drained before the worker stops
+        if (stop_token.stop_requested() && m_queue.empty())
+        {
+          return;
+        }
+        execute_next(lock);
+      }
+    }
+
+    // The lock is released during the execution
+    void execute_next(std::unique_lock<std::mutex>& lock)
+    {
+      std::optional<std::function<void()>> callback =
+          m_queue.pop(worker_clock_t::now());
+      if (callback.has_value() == false)
+      {
+        return;
+      }
+      lock.unlock();
+      {
+        CF_PROFILE_SCOPE_N("worker_pool_t::execute");
+        (*callback)();
+      }
+      callback.reset();
+      lock.lock();
+    }
+
+    queue_t m_queue;
+    mutable std::mutex m_queue_mutex;
+    std::condition_variable_any m_queue_condition;
+    std::vector<std::jthread> m_workers;
+};
+} // namespace coroutine_flow::__details
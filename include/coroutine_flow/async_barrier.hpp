@@ -0,0 +1,100 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <cstddef>
+#include <mutex>
+
+namespace coroutine_flow
+{
+class async_barrier;
+
+namespace __details
+{
+  class async_barrier_arrive_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_barrier_arrive_awaitable_t(async_barrier& barrier) noexcept
+          : m_barrier(&barrier)
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(suspended_task_t suspended_task);
+      void await_resume() const noexcept {}
+
+    private:
+      async_barrier* m_barrier;
+  };
+} // namespace __details
+
+/**
+ * Reusable barrier for a fixed number of coroutines, like std::barrier
+ * without completion function: the coroutines of a phase wait until every
+ * one of them arrived, then they are continued on their own schedulers and
+ * the next phase starts. The last arriving coroutine doesn't suspend.
+ *
+ * The waiters aren't cancelled by a stop request: their arrival is already
+ * counted for the phase, the others would wait for a coroutine that left.
+ *
+ * cf::async_barrier phase_end(workers);
+ * ... every worker, after each phase:
+ * co_await phase_end.arrive_and_wait();
+ */
+class async_barrier
+{
+    friend class __details::async_barrier_arrive_awaitable_t;
+
+  public:
+    explicit async_barrier(std::size_t expected)
+        : m_expected(expected)
+    {
+    }
+    async_barrier(const async_barrier&) = delete;
+    async_barrier& operator=(const async_barrier&) = delete;
+
+    __details::async_barrier_arrive_awaitable_t arrive_and_wait() noexcept
+    {
+      return __details::async_barrier_arrive_awaitable_t(*this);
+    }
+    // Number of the finished phases
+    std::size_t phase() const
+    {
+      std::lock_guard lock(m_mutex);
+      return m_phase;
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    const std::size_t m_expected;
+    std::size_t m_arrived{ 0 };
+    std::size_t m_phase{ 0 };
+    __details::waiter_queue_t m_waiters;
+};
+
+namespace __details
+{
+  inline bool async_barrier_arrive_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    waiter_queue_t resumed;
+    {
+      std::lock_guard lock(m_barrier->m_mutex);
+      if (++m_barrier->m_arrived < m_barrier->m_expected)
+      {
+        this->suspended_task.emplace(std::move(suspended_task));
+        m_barrier->m_waiters.push_back(this);
+        return true;
+      }
+      m_barrier->m_arrived = 0;
+      ++m_barrier->m_phase;
+      resumed = std::move(m_barrier->m_waiters);
+    }
+    resumed.resume_all();
+    return false;
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/shared_task.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+struct async_cache_stats
+{
+    // The value was already available
+    std::uint64_t hits{ 0 };
+    // The loader was started
+    std::uint64_t misses{ 0 };
+    // The value was being loaded, the request waited for it
+    std::uint64_t coalesced{ 0 };
+    // Entries dropped because of the size bound
+    std::uint64_t evictions{ 0 };
+};
+
+template <typename K, typename V, typename hash_t>
+class async_cache;
+
+namespace __details
+{
+  template <typename K, typename V, typename hash_t>
+  class async_cache_get_awaitable_t
+  {
+      using cache_t = async_cache<K, V, hash_t>;
+
+    public:
+      async_cache_get_awaitable_t(cache_t& cache, K key, shared_task<V> value)
+          : m_cache(&cache)
+          , m_key(std::move(key))
+          , m_value(std::move(value))
+      {
+      }
+
+      bool await_ready() const { return m_value.await_ready(); }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        return m_value.await_suspend(std::move(suspended_task));
+      }
+      // The value is copied, the entry might be evicted meanwhile
+      V await_resume()
+      {
+        try
+        {
+          return m_value.await_resume();
+        }
+        catch (...)
+        {
+          // Failures aren't cached, the next request loads again
+          m_cache->erase_failed(m_key, m_value);
+          throw;
+        }
+      }
+
+    private:
+      cache_t* m_cache;
+      K m_key;
+      shared_task<V> m_value;
+  };
+} // namespace __details
+
+/**
+ * Caches the results of asynchronous loads (single-flight): the loader of a
+ * key runs once while it's in flight, the concurrent requests of the same
+ * key wait for that load instead of starting their own. The finished values
+ * are served without suspending. Failed loads aren't cached.
+ *
+ * The table is split into shards by the hash of the key, each one has its
+ * own lock and LRU list, the capacity is divided among them. The loader is
+ * called under the lock of the shard, it should only create the task.
+ * Values are returned by copy, thus large values are worth to be shared,
+ * e.g. std::shared_ptr<const index_t>.
+ *
+ * cf::async_cache<std::string, int> cache(1024);
+ * int value = co_await cache.get_or_compute(key, [&] { return fetch(key); });
+ */
+template <typename K, typename V, typename hash_t = std::hash<K>>
+class async_cache
+{
+    friend class __details::async_cache_get_awaitable_t<K, V, hash_t>;
+
+    struct entry_t
+    {
+        K key;
+        shared_task<V> value;
+    };
+    struct shard_t
+    {
+        mutable std::mutex mutex;
+        // Most recently used first
+        std::list<entry_t> lru;
+        std::unordered_map<K, typename std::list<entry_t>::iterator, hash_t>
+            entries;
+    };
+
+  public:
+    static constexpr std::size_t c_default_shard_count = 16;
+
+    explicit async_cache(std::size_t capacity,
+                         std::size_t shard_count = c_default_shard_count)
+        : m_shards(std::max<std::size_t>(1, std::min(shard_count, capacity)))
+        , m_shard_capacity(
+              std::max<std::size_t>(1,
+                                    (capacity + m_shards.size() - 1) /
+                                        m_shards.size()))
+    {
+    }
+    async_cache(const async_cache&) = delete;
+    async_cache& operator=(const async_cache&) = delete;
+
+    template <typename loader_t>
+      requires std::same_as<std::invoke_result_t<loader_t&>, task<V>>
+    __details::async_cache_get_awaitable_t<K, V, hash_t>
+        get_or_compute(const K& key, loader_t&& loader)
+    {
+      CF_PROFILE_SCOPE();
+      shard_t& shard = get_shard(key);
+      std::lock_guard lock(shard.mutex);
+      if (auto it = shard.entries.find(key); it != shard.entries.end())
+      {
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        const shared_task<V>& value = it->second->value;
+        count(value.is_ready() ? m_hits : m_coalesced);
+        return { *this, key, value };
+      }
+      count(m_misses);
+      shard.lru.push_front(entry_t{ key, shared_task<V>(loader()) });
+      shard.entries.emplace(key, shard.lru.begin());
+      evict(shard);
+      return { *this, key, shard.lru.front().value };
+    }
+
+    void erase(const K& key)
+    {
+      shard_t& shard = get_shard(key);
+      std::lock_guard lock(shard.mutex);
+      if (auto it = shard.entries.find(key); it != shard.entries.end())
+      {
+        shard.lru.erase(it->second);
+        shard.entries.erase(it);
+      }
+    }
+    std::size_t size() const
+    {
+      std::size_t result = 0;
+      for (const shard_t& shard : m_shards)
+      {
+        std::lock_guard lock(shard.mutex);
+        result += shard.lru.size();
+      }
+      return result;
+    }
+    async_cache_stats stats() const
+    {
+      return { m_hits.load(std::memory_order_relaxed),
+               m_misses.load(std::memory_order_relaxed),
+               m_coalesced.load(std::memory_order_relaxed),
+               m_evictions.load(std::memory_order_relaxed) };
+    }
+
+  private:
+    static void count(std::atomic_uint64_t& counter)
+    {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard_t& get_shard(const K& key)
+    {
+      return m_shards[hash_t{}(key) % m_shards.size()];
+    }
+    /**
+     * Drops the least recently used finished values while the shard is over
+     * its capacity. In flight loads are kept, otherwise a new request of the
+     * key would start the load again. Thus, the shard can exceed its
+     * capacity while the loads are in flight.
+     */
+    void evict(shard_t& shard)
+    {
+      auto victim = shard.lru.end();
+      while (shard.lru.size() > m_shard_capacity)
+      {
+        victim = std::find_if(std::make_reverse_iterator(victim),
+                              shard.lru.rend(),
+                              [](const entry_t& entry)
+                              { return entry.value.is_ready(); })
+                     .base();
+        if (victim == shard.lru.begin())
+        {
+          return;
+        }
+        --victim;
+        shard.entries.erase(victim->key);
+        victim = shard.lru.erase(victim);
+        count(m_evictions);
+      }
+    }
+    // Removes the entry only if it's still the failed load
+    void erase_failed(const K& key, const shared_task<V>& failed)
+    {
+      shard_t& shard = get_shard(key);
+      std::lock_guard lock(shard.mutex);
+      auto it = shard.entries.find(key);
+      if (it != shard.entries.end() && it->second->value == failed)
+      {
+        shard.lru.erase(it->second);
+        shard.entries.erase(it);
+      }
+    }
+
+    std::vector<shard_t> m_shards;
+    std::size_t m_shard_capacity;
+    std::atomic_uint64_t m_hits{ 0 };
+    std::atomic_uint64_t m_misses{ 0 };
+    std::atomic_uint64_t m_coalesced{ 0 };
+    std::atomic_uint64_t m_evictions{ 0 };
+};
+} // namespace coroutine_flow
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/async_mutex.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <cassert>
+#include <mutex>
+#include <utility>
+
+namespace coroutine_flow
+{
+class async_condition_variable;
+
+namespace __details
+{
+  class async_condition_variable_wait_awaitable_t : public waiter_node_t
+  {
+      friend class coroutine_flow::async_condition_variable;
+
+    public:
+      async_condition_variable_wait_awaitable_t(
+          async_condition_variable& condition_variable,
+          async_mutex& mutex) noexcept
+          : m_condition_variable(&condition_variable)
+          , m_mutex(&mutex)
+          , m_relock(mutex)
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(suspended_task_t suspended_task);
+      void await_resume() { finish_waiting(); }
+
+    private:
+      static void cancel(waiter_node_t& waiter);
+      // The waiter is continued when it owns the mutex again
+      void notify()
+      {
+        m_relock.lock_and_resume(*std::exchange(suspended_task, std::nullopt));
+      }
+
+      async_condition_variable* m_condition_variable;
+      async_mutex* m_mutex;
+      async_mutex_lock_awaitable_t m_relock;
+  };
+} // namespace __details
+
+/**
+ * Condition variable for coroutines that wait under a cf::async_mutex. The
+ * wait unlocks the mutex and suspends the coroutine, it continues after a
+ * notification, when it owns the mutex again. Notified waiters aren't
+ * resumed only to block on the mutex: they are moved to the waiters of the
+ * mutex, thus notify_all continues them one by one as the mutex is handed
+ * over. As with std::condition_variable, the condition has to be checked in
+ * a loop. A waiter whose stop is requested leaves the wait with
+ * operation_cancelled_error, it owns the mutex again by then.
+ *
+ * auto lock = co_await mutex.lock();
+ * while (queue.empty())
+ * {
+ *   co_await not_empty.wait(lock);
+ * }
+ */
+class async_condition_variable
+{
+    friend class __details::async_condition_variable_wait_awaitable_t;
+    using waiter_t = __details::async_condition_variable_wait_awaitable_t;
+
+  public:
+    async_condition_variable() = default;
+    async_condition_variable(const async_condition_variable&) = delete;
+    async_condition_variable&
+        operator=(const async_condition_variable&) = delete;
+
+    // The lock has to own its mutex, it owns it again when the wait returns
+    waiter_t wait(async_mutex_lock& lock) noexcept
+    {
+      assert(lock.mutex() != nullptr);
+      return waiter_t(*this, *lock.mutex());
+    }
+    void notify_one()
+    {
+      waiter_t* waiter = nullptr;
+      {
+        std::lock_guard lock(m_mutex);
+        if (m_waiters.empty())
+        {
+          return;
+        }
+        waiter = static_cast<waiter_t*>(m_waiters.pop_front());
+      }
+      waiter->notify();
+    }
+    void notify_all()
+    {
+      CF_PROFILE_SCOPE();
+      __details::waiter_queue_t notified;
+      {
+        std::lock_guard lock(m_mutex);
+        notified = std::move(m_waiters);
+      }
+      while (notified.empty() == false)
+      {
+        static_cast<waiter_t*>(notified.pop_front())->notify();
+      }
+    }
+
+  private:
+    std::mutex m_mutex;
+    __details::waiter_queue_t m_waiters;
+};
+
+namespace __details
+{
+  inline bool async_condition_variable_wait_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    enable_cancellation(suspended_task.context().stop_token, &cancel);
+    async_mutex* mutex = m_mutex;
+    {
+      std::lock_guard lock(m_condition_variable->m_mutex);
+      if (cancelled())
+      {
+        // The mutex is still owned
+        return false;
+      }
+      this->suspended_task.emplace(std::move(suspended_task));
+      state = state_t::waiting;
+      m_condition_variable->m_waiters.push_back(this);
+    }
+    // Notifications can't be missed, the waiter is already queued. This
+    // awaitable mustn't be touched after the unlock, it might be resumed.
+    mutex->unlock();
+    return true;
+  }
+  inline void
+      async_condition_variable_wait_awaitable_t::cancel(waiter_node_t& waiter)
+  {
+    auto& awaitable =
+        static_cast<async_condition_variable_wait_awaitable_t&>(waiter);
+    {
+      std::lock_guard lock(awaitable.m_condition_variable->m_mutex);
+      if (awaitable.m_condition_variable->m_waiters.cancel(&waiter) == false)
+      {
+        return;
+      }
+    }
+    // Like a notification, it's continued when it owns the mutex again
+    awaitable.notify();
+  }
+} // namespace __details
+} // namespace coroutine_flow
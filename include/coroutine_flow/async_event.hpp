@@ -0,0 +1,164 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <atomic>
+#include <mutex>
+
+namespace coroutine_flow
+{
+class async_event;
+
+enum class async_event_reset
+{
+  // Stays set until reset() is called, every waiter is continued
+  manual,
+  // One waiter is continued per set(), it resets the event
+  automatic
+};
+
+namespace __details
+{
+  class async_event_wait_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_event_wait_awaitable_t(async_event& event) noexcept
+          : m_event(&event)
+      {
+      }
+
+      bool await_ready() noexcept;
+      bool await_suspend(suspended_task_t suspended_task);
+      void await_resume() { finish_waiting(); }
+
+    private:
+      static void cancel(waiter_node_t& waiter);
+
+      async_event* m_event;
+  };
+} // namespace __details
+
+/**
+ * Signals an event to coroutines, e.g. that the initialization is finished.
+ * Waiting for a set event doesn't suspend. The waiters are linked into a
+ * queue through their awaiters, thus waiting doesn't allocate. Setting a
+ * manual reset event continues all of the waiters, the ones of the same
+ * scheduler are handed over to it in one batch. A waiter whose stop is
+ * requested leaves the queue with operation_cancelled_error.
+ *
+ * cf::async_event initialized;
+ * co_await initialized.wait();
+ * ...
+ * initialized.set();
+ */
+class async_event
+{
+    friend class __details::async_event_wait_awaitable_t;
+
+  public:
+    explicit async_event(bool set = false,
+                         async_event_reset reset = async_event_reset::manual)
+        : m_reset(reset)
+        , m_set(set)
+    {
+    }
+    async_event(const async_event&) = delete;
+    async_event& operator=(const async_event&) = delete;
+
+    __details::async_event_wait_awaitable_t wait() noexcept
+    {
+      return __details::async_event_wait_awaitable_t(*this);
+    }
+    void set()
+    {
+      CF_PROFILE_SCOPE();
+      __details::waiter_queue_t resumed;
+      {
+        std::lock_guard lock(m_mutex);
+        if (m_reset == async_event_reset::manual)
+        {
+          m_set.store(true, std::memory_order_release);
+          resumed = std::move(m_waiters);
+        }
+        else if (m_waiters.empty())
+        {
+          // Consumed by the next waiter
+          m_set.store(true, std::memory_order_release);
+        }
+        else
+        {
+          resumed.push_back(m_waiters.pop_front());
+        }
+      }
+      resumed.resume_all();
+    }
+    void reset() noexcept { m_set.store(false, std::memory_order_relaxed); }
+    bool is_set() const noexcept
+    {
+      return m_set.load(std::memory_order_acquire);
+    }
+
+  private:
+    // Consumes the signal of an automatic reset event
+    bool try_consume() noexcept
+    {
+      if (m_reset == async_event_reset::manual)
+      {
+        return is_set();
+      }
+      bool expected = true;
+      return m_set.compare_exchange_strong(expected,
+                                           false,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+    }
+
+    const async_event_reset m_reset;
+    std::atomic_bool m_set;
+    std::mutex m_mutex;
+    __details::waiter_queue_t m_waiters;
+};
+
+namespace __details
+{
+  inline bool async_event_wait_awaitable_t::await_ready() noexcept
+  {
+    return m_event->try_consume();
+  }
+  inline bool async_event_wait_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    enable_cancellation(suspended_task.context().stop_token, &cancel);
+    std::lock_guard lock(m_event->m_mutex);
+    if (cancelled())
+    {
+      return false;
+    }
+    if (m_event->try_consume())
+    {
+      state = state_t::finished;
+      return false;
+    }
+    this->suspended_task.emplace(std::move(suspended_task));
+    state = state_t::waiting;
+    m_event->m_waiters.push_back(this);
+    return true;
+  }
+  inline void async_event_wait_awaitable_t::cancel(waiter_node_t& waiter)
+  {
+    async_event* event =
+        static_cast<async_event_wait_awaitable_t&>(waiter).m_event;
+    {
+      std::lock_guard lock(event->m_mutex);
+      if (event->m_waiters.cancel(&waiter) == false)
+      {
+        return;
+      }
+    }
+    waiter.resume();
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+
+namespace coroutine_flow
+{
+class async_latch;
+
+namespace __details
+{
+  class async_latch_wait_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_latch_wait_awaitable_t(async_latch& latch) noexcept
+          : m_latch(&latch)
+      {
+      }
+
+      bool await_ready() const;
+      bool await_suspend(suspended_task_t suspended_task);
+      void await_resume() { finish_waiting(); }
+
+    private:
+      static void cancel(waiter_node_t& waiter);
+
+      async_latch* m_latch;
+  };
+} // namespace __details
+
+/**
+ * Single use countdown, like std::latch: the waiting coroutines are
+ * continued (on their own schedulers) when the counter reaches zero. A
+ * waiter whose stop is requested leaves with operation_cancelled_error.
+ *
+ * cf::async_latch ready(3);
+ * ... every producer calls ready.count_down();
+ * co_await ready.wait();
+ */
+class async_latch
+{
+    friend class __details::async_latch_wait_awaitable_t;
+
+  public:
+    explicit async_latch(std::size_t expected)
+        : m_remaining(expected)
+    {
+    }
+    async_latch(const async_latch&) = delete;
+    async_latch& operator=(const async_latch&) = delete;
+
+    void count_down(std::size_t count = 1)
+    {
+      CF_PROFILE_SCOPE();
+      __details::waiter_queue_t resumed;
+      {
+        std::lock_guard lock(m_mutex);
+        assert(count <= m_remaining);
+        m_remaining -= count;
+        if (m_remaining != 0)
+        {
+          return;
+        }
+        resumed = std::move(m_waiters);
+      }
+      resumed.resume_all();
+    }
+    bool try_wait() const
+    {
+      std::lock_guard lock(m_mutex);
+      return m_remaining == 0;
+    }
+    __details::async_latch_wait_awaitable_t wait() noexcept
+    {
+      return __details::async_latch_wait_awaitable_t(*this);
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    std::size_t m_remaining;
+    __details::waiter_queue_t m_waiters;
+};
+
+namespace __details
+{
+  inline bool async_latch_wait_awaitable_t::await_ready() const
+  {
+    return m_latch->try_wait();
+  }
+  inline bool
+      async_latch_wait_awaitable_t::await_suspend(suspended_task_t suspended)
+  {
+    CF_PROFILE_SCOPE();
+    enable_cancellation(suspended.context().stop_token, &cancel);
+    std::lock_guard lock(m_latch->m_mutex);
+    if (cancelled())
+    {
+      return false;
+    }
+    if (m_latch->m_remaining == 0)
+    {
+      state = state_t::finished;
+      return false;
+    }
+    this->suspended_task.emplace(std::move(suspended));
+    state = state_t::waiting;
+    m_latch->m_waiters.push_back(this);
+    return true;
+  }
+  inline void async_latch_wait_awaitable_t::cancel(waiter_node_t& waiter)
+  {
+    async_latch* latch =
+        static_cast<async_latch_wait_awaitable_t&>(waiter).m_latch;
+    {
+      std::lock_guard lock(latch->m_mutex);
+      if (latch->m_waiters.cancel(&waiter) == false)
+      {
+        return;
+      }
+    }
+    waiter.resume();
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace coroutine_flow
+{
+class async_mutex;
+
+// Owns the lock of an async_mutex, it's released when it's destroyed.
+class async_mutex_lock
+{
+  public:
+    explicit async_mutex_lock(async_mutex& mutex) noexcept
+        : m_mutex(&mutex)
+    {
+    }
+    async_mutex_lock(async_mutex_lock&& other) noexcept
+        : m_mutex(std::exchange(other.m_mutex, nullptr))
+    {
+    }
+    async_mutex_lock(const async_mutex_lock&) = delete;
+    async_mutex_lock& operator=(const async_mutex_lock&) = delete;
+    async_mutex_lock& operator=(async_mutex_lock&&) = delete;
+    ~async_mutex_lock() { unlock(); }
+
+    void unlock();
+    // The mutex is null when the lock is already released
+    async_mutex* mutex() const noexcept { return m_mutex; }
+
+  private:
+    async_mutex* m_mutex;
+};
+
+namespace __details
+{
+  /**
+   * The waiter is the awaitable itself, it lives in the frame of the
+   * suspended coroutine while it's in the waiter list, thus locking doesn't
+   * allocate.
+   */
+  class async_mutex_lock_awaitable_t
+  {
+      friend class coroutine_flow::async_mutex;
+
+    public:
+      explicit async_mutex_lock_awaitable_t(async_mutex& mutex) noexcept
+          : m_mutex(&mutex)
+      {
+      }
+
+      bool await_ready() const noexcept;
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        m_suspended_task.emplace(std::move(suspended_task));
+        if (lock_or_wait())
+        {
+          return true;
+        }
+        m_suspended_task.reset();
+        return false;
+      }
+      async_mutex_lock await_resume() const noexcept
+      {
+        return async_mutex_lock(*m_mutex);
+      }
+      /**
+       * Locks on behalf of an already suspended task (e.g. a condition
+       * variable waiter), the task is continued when it owns the lock.
+       */
+      void lock_and_resume(suspended_task_t suspended_task)
+      {
+        m_suspended_task.emplace(std::move(suspended_task));
+        if (lock_or_wait() == false)
+        {
+          std::exchange(m_suspended_task, std::nullopt)->resume();
+        }
+      }
+
+    private:
+      // Returns false when the lock is acquired instead of waiting for it
+      bool lock_or_wait();
+
+      async_mutex* m_mutex;
+      async_mutex_lock_awaitable_t* m_next{ nullptr };
+      std::optional<suspended_task_t> m_suspended_task;
+  };
+} // namespace __details
+
+/**
+ * Mutual exclusion for coroutines without blocking the workers: a coroutine
+ * that doesn't get the lock is suspended and the worker continues with other
+ * tasks. Unlock hands the lock over directly to the next waiter (FIFO) and
+ * continues it on its own scheduler.
+ *
+ * The state is a single atomic word: not locked, locked without waiters or
+ * the head of the waiters that arrived since the last unlock. Those are
+ * pushed lock-free and taken over in a batch by the owner of the lock, which
+ * reverses them to arrival order.
+ *
+ * The waiters aren't cancelled by a stop request: they are linked into the
+ * atomic word and only the owner of the lock can unlink them. The critical
+ * sections are expected to be short, the stop is noticed after them.
+ *
+ * cf::async_mutex mutex;
+ * {
+ *   auto lock = co_await mutex.lock();
+ *   ...
+ * }
+ */
+class async_mutex
+{
+    friend class __details::async_mutex_lock_awaitable_t;
+    using waiter_t = __details::async_mutex_lock_awaitable_t;
+
+    static constexpr std::uintptr_t c_not_locked = 1;
+    static constexpr std::uintptr_t c_locked_no_waiters = 0;
+
+  public:
+    async_mutex() = default;
+    async_mutex(const async_mutex&) = delete;
+    async_mutex& operator=(const async_mutex&) = delete;
+    ~async_mutex()
+    {
+      assert(m_state.load(std::memory_order_relaxed) == c_not_locked &&
+             m_waiters == nullptr);
+    }
+
+    // co_await returns an async_mutex_lock
+    waiter_t lock() noexcept { return waiter_t(*this); }
+    bool try_lock() noexcept
+    {
+      std::uintptr_t expected = c_not_locked;
+      return m_state.compare_exchange_strong(expected,
+                                             c_locked_no_waiters,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+    void unlock()
+    {
+      assert(m_state.load(std::memory_order_relaxed) != c_not_locked);
+      waiter_t* head = m_waiters;
+      if (head == nullptr)
+      {
+        std::uintptr_t expected = c_locked_no_waiters;
+        if (m_state.compare_exchange_strong(expected,
+                                            c_not_locked,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed))
+        {
+          return;
+        }
+        // Take over the new waiters, they were pushed in reverse order
+        auto* waiter = reinterpret_cast<waiter_t*>(
+            m_state.exchange(c_locked_no_waiters, std::memory_order_acquire));
+        do
+        {
+          waiter_t* next = waiter->m_next;
+          waiter->m_next = head;
+          head = waiter;
+          waiter = next;
+        } while (waiter != nullptr);
+      }
+      // The lock is kept, it's handed over to the next waiter
+      m_waiters = head->m_next;
+      CF_PROFILE_SCOPE();
+      std::exchange(head->m_suspended_task, std::nullopt)->resume();
+    }
+
+  private:
+    std::atomic_uintptr_t m_state{ c_not_locked };
+    // Accessed only by the owner of the lock
+    waiter_t* m_waiters{ nullptr };
+};
+
+inline void async_mutex_lock::unlock()
+{
+  if (m_mutex != nullptr)
+  {
+    std::exchange(m_mutex, nullptr)->unlock();
+  }
+}
+
+namespace __details
+{
+  inline bool async_mutex_lock_awaitable_t::await_ready() const noexcept
+  {
+    return m_mutex->try_lock();
+  }
+  inline bool async_mutex_lock_awaitable_t::lock_or_wait()
+  {
+    std::uintptr_t state = m_mutex->m_state.load(std::memory_order_acquire);
+    while (true)
+    {
+      if (state == async_mutex::c_not_locked)
+      {
+        if (m_mutex->m_state.compare_exchange_weak(
+                state,
+                async_mutex::c_locked_no_waiters,
+                std::memory_order_acquire,
+                std::memory_order_relaxed))
+        {
+          return false;
+        }
+      }
+      else
+      {
+        m_next = reinterpret_cast<async_mutex_lock_awaitable_t*>(state);
+        if (m_mutex->m_state.compare_exchange_weak(
+                state,
+                reinterpret_cast<std::uintptr_t>(this),
+                std::memory_order_release,
+                std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+    }
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/__details/submit_buffer.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  /**
+   * Shared by the scope and its spawned coroutines, thus the last one can
+   * notify the joiners even when the scope is destroyed right after.
+   */
+  class async_scope_state_t
+  {
+    public:
+      void on_spawned()
+      {
+        m_in_flight.fetch_add(1, std::memory_order_relaxed);
+      }
+      void on_finished()
+      {
+        if (m_in_flight.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+          return;
+        }
+        m_in_flight.notify_all();
+        std::vector<cancellable_suspend_t::resumer_t> joiners;
+        {
+          std::lock_guard lock(m_mutex);
+          joiners.swap(m_joiners);
+        }
+        for (const auto& joiner : joiners)
+        {
+          joiner.resume();
+        }
+      }
+      // Returns false when nothing is in flight, then there's nothing to wait
+      bool add_joiner(cancellable_suspend_t::resumer_t joiner)
+      {
+        std::lock_guard lock(m_mutex);
+        if (in_flight() == 0)
+        {
+          return false;
+        }
+        m_joiners.push_back(std::move(joiner));
+        return true;
+      }
+      void wait()
+      {
+        std::size_t in_flight = m_in_flight.load(std::memory_order_acquire);
+        while (in_flight != 0)
+        {
+          m_in_flight.wait(in_flight, std::memory_order_acquire);
+          in_flight = m_in_flight.load(std::memory_order_acquire);
+        }
+      }
+      std::size_t in_flight() const
+      {
+        return m_in_flight.load(std::memory_order_acquire);
+      }
+      std::stop_source& stop_source() { return m_stop_source; }
+
+    private:
+      std::atomic_size_t m_in_flight{ 0 };
+      std::stop_source m_stop_source;
+      std::mutex m_mutex;
+      std::vector<cancellable_suspend_t::resumer_t> m_joiners;
+  };
+
+  /**
+   * Counts a spawned coroutine as finished when it's destroyed. It's a
+   * parameter of the wrapper coroutine, thus the counter is decremented even
+   * when the wrapper doesn't start (e.g. stop was requested before).
+   */
+  class in_flight_guard_t
+  {
+    public:
+      explicit in_flight_guard_t(std::shared_ptr<async_scope_state_t> state)
+          : m_state(std::move(state))
+      {
+        m_state->on_spawned();
+      }
+      in_flight_guard_t(in_flight_guard_t&&) = default;
+      in_flight_guard_t& operator=(in_flight_guard_t&&) = delete;
+      ~in_flight_guard_t()
+      {
+        if (m_state != nullptr)
+        {
+          m_state->on_finished();
+        }
+      }
+
+    private:
+      std::shared_ptr<async_scope_state_t> m_state;
+  };
+
+  // The exception of a spawned coroutine is dropped, like with run_async.
+  template <typename T>
+  task<int> run_in_scope(task<T> spawned, in_flight_guard_t)
+  {
+    try
+    {
+      co_await std::move(spawned);
+    }
+    catch (...)
+    {
+    }
+    co_return 0;
+  }
+
+  class async_scope_join_awaitable_t
+  {
+    public:
+      explicit async_scope_join_awaitable_t(
+          std::shared_ptr<async_scope_state_t> state)
+          : m_state(std::move(state))
+      {
+      }
+
+      bool await_ready() const { return m_state->in_flight() == 0; }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        auto resumer = m_suspend.begin(std::move(suspended_task));
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        if (m_state->add_joiner(*resumer) == false)
+        {
+          resumer->resume_inline();
+        }
+        return m_suspend.end();
+      }
+      void await_resume() { m_suspend.finish(); }
+
+    private:
+      std::shared_ptr<async_scope_state_t> m_state;
+      cancellable_suspend_t m_suspend;
+  };
+} // namespace __details
+
+/**
+ * Owns the coroutines that run in the background: spawn starts them like
+ * run_async, join waits until every spawned coroutine is finished. The
+ * number of the running coroutines is an atomic counter, spawning doesn't
+ * lock. The scope must be joined before it's destroyed.
+ *
+ * cf::async_scope scope;
+ * scope.spawn(handle_request(request), &thread_pool);
+ * ...
+ * co_await scope.join();
+ */
+class async_scope
+{
+  public:
+    async_scope()
+        : m_state(std::make_shared<__details::async_scope_state_t>())
+    {
+    }
+    async_scope(const async_scope&) = delete;
+    async_scope& operator=(const async_scope&) = delete;
+    ~async_scope()
+    {
+      assert(m_state->in_flight() == 0 &&
+             "The async_scope is destroyed with running coroutines.");
+    }
+
+    /**
+     * Starts the coroutine on the scheduler. It gets the stop token of the
+     * scope (see request_stop), its exception is dropped.
+     */
+    template <typename T, task_scheduler scheduler_t>
+    void spawn(task<T>&& task, scheduler_t scheduler, schedule_hints_t hints)
+    {
+      CF_PROFILE_SCOPE();
+      run_async(__details::run_in_scope(
+                    std::move(task),
+                    __details::in_flight_guard_t(m_state)),
+                std::move(scheduler),
+                hints,
+                m_state->stop_source().get_token());
+    }
+    template <typename T, task_scheduler scheduler_t>
+    void spawn(task<T>&& task, scheduler_t scheduler)
+    {
+      spawn(std::move(task), std::move(scheduler), schedule_hints_t{});
+    }
+
+    // Continues the awaiting coroutine when nothing is in flight.
+    __details::async_scope_join_awaitable_t join() const
+    {
+      return __details::async_scope_join_awaitable_t(m_state);
+    }
+    /**
+     * Blocks the calling thread until nothing is in flight. It must not be
+     * called from a worker that the spawned coroutines need.
+     */
+    void join_sync() const
+    {
+      // Called from a coroutine the spawned ones might be buffered
+      __details::submit_buffer_t::instance().flush();
+      m_state->wait();
+    }
+
+    // Requests stop for every spawned coroutine, they still have to be joined
+    void request_stop() { m_state->stop_source().request_stop(); }
+    std::size_t in_flight() const { return m_state->in_flight(); }
+
+  private:
+    std::shared_ptr<__details::async_scope_state_t> m_state;
+};
+} // namespace coroutine_flow
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <cstddef>
+#include <mutex>
+
+namespace coroutine_flow
+{
+class async_semaphore;
+
+namespace __details
+{
+  class async_semaphore_acquire_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_semaphore_acquire_awaitable_t(
+          async_semaphore& semaphore) noexcept
+          : m_semaphore(&semaphore)
+      {
+      }
+
+      bool await_ready() const;
+      bool await_suspend(suspended_task_t suspended_task);
+      void await_resume() { finish_waiting(); }
+
+    private:
+      static void cancel(waiter_node_t& waiter);
+
+      async_semaphore* m_semaphore;
+  };
+} // namespace __details
+
+/**
+ * Counting semaphore for coroutines, e.g. to bound the number of concurrent
+ * requests towards a dependency. A coroutine that can't acquire is suspended
+ * without blocking its worker. Release hands the permits over directly to
+ * the waiters (FIFO), they are continued on their own schedulers. A waiter
+ * whose stop is requested leaves the queue with operation_cancelled_error.
+ *
+ * cf::async_semaphore semaphore(8);
+ * co_await semaphore.acquire();
+ * ...
+ * semaphore.release();
+ */
+class async_semaphore
+{
+    friend class __details::async_semaphore_acquire_awaitable_t;
+
+  public:
+    explicit async_semaphore(std::size_t permits)
+        : m_permits(permits)
+    {
+    }
+    async_semaphore(const async_semaphore&) = delete;
+    async_semaphore& operator=(const async_semaphore&) = delete;
+
+    __details::async_semaphore_acquire_awaitable_t acquire() noexcept
+    {
+      return __details::async_semaphore_acquire_awaitable_t(*this);
+    }
+    bool try_acquire()
+    {
+      std::lock_guard lock(m_mutex);
+      // The waiters are served first
+      if (m_permits == 0 || m_waiters.empty() == false)
+      {
+        return false;
+      }
+      --m_permits;
+      return true;
+    }
+    // Releases several permits at once, e.g. when a batch is finished.
+    void release(std::size_t count = 1)
+    {
+      CF_PROFILE_SCOPE();
+      __details::waiter_queue_t resumed;
+      {
+        std::lock_guard lock(m_mutex);
+        for (; count > 0 && m_waiters.empty() == false; --count)
+        {
+          resumed.push_back(m_waiters.pop_front());
+        }
+        m_permits += count;
+      }
+      resumed.resume_all();
+    }
+    std::size_t available() const
+    {
+      std::lock_guard lock(m_mutex);
+      return m_permits;
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    std::size_t m_permits;
+    __details::waiter_queue_t m_waiters;
+};
+
+namespace __details
+{
+  inline bool async_semaphore_acquire_awaitable_t::await_ready() const
+  {
+    return m_semaphore->try_acquire();
+  }
+  inline bool async_semaphore_acquire_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    enable_cancellation(suspended_task.context().stop_token, &cancel);
+    std::lock_guard lock(m_semaphore->m_mutex);
+    if (cancelled())
+    {
+      return false;
+    }
+    if (m_semaphore->m_permits > 0 && m_semaphore->m_waiters.empty())
+    {
+      --m_semaphore->m_permits;
+      state = state_t::finished;
+      return false;
+    }
+    this->suspended_task.emplace(std::move(suspended_task));
+    state = state_t::waiting;
+    m_semaphore->m_waiters.push_back(this);
+    return true;
+  }
+  inline void async_semaphore_acquire_awaitable_t::cancel(
+      waiter_node_t& waiter)
+  {
+    async_semaphore* semaphore =
+        static_cast<async_semaphore_acquire_awaitable_t&>(waiter).m_semaphore;
+    {
+      std::lock_guard lock(semaphore->m_mutex);
+      if (semaphore->m_waiters.cancel(&waiter) == false)
+      {
+        return;
+      }
+    }
+    waiter.resume();
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace coroutine_flow
+{
+class async_shared_mutex;
+
+/**
+ * Owns the exclusive or the shared lock of an async_shared_mutex, it's
+ * released when it's destroyed.
+ */
+class async_shared_mutex_lock
+{
+  public:
+    async_shared_mutex_lock(async_shared_mutex& mutex, bool shared) noexcept
+        : m_mutex(&mutex)
+        , m_shared(shared)
+    {
+    }
+    async_shared_mutex_lock(async_shared_mutex_lock&& other) noexcept
+        : m_mutex(std::exchange(other.m_mutex, nullptr))
+        , m_shared(other.m_shared)
+    {
+    }
+    async_shared_mutex_lock(const async_shared_mutex_lock&) = delete;
+    async_shared_mutex_lock&
+        operator=(const async_shared_mutex_lock&) = delete;
+    async_shared_mutex_lock& operator=(async_shared_mutex_lock&&) = delete;
+    ~async_shared_mutex_lock() { unlock(); }
+
+    void unlock();
+
+  private:
+    async_shared_mutex* m_mutex;
+    bool m_shared;
+};
+
+namespace __details
+{
+  class async_shared_mutex_lock_shared_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_shared_mutex_lock_shared_awaitable_t(
+          async_shared_mutex& mutex) noexcept
+          : m_mutex(&mutex)
+      {
+      }
+
+      bool await_ready() noexcept;
+      bool await_suspend(suspended_task_t suspended_task);
+      async_shared_mutex_lock await_resume() const noexcept
+      {
+        return async_shared_mutex_lock(*m_mutex, true);
+      }
+
+    private:
+      async_shared_mutex* m_mutex;
+  };
+
+  class async_shared_mutex_lock_awaitable_t : public waiter_node_t
+  {
+    public:
+      explicit async_shared_mutex_lock_awaitable_t(
+          async_shared_mutex& mutex) noexcept
+          : m_mutex(&mutex)
+      {
+      }
+
+      bool await_ready();
+      bool await_suspend(suspended_task_t suspended_task);
+      async_shared_mutex_lock await_resume() const noexcept
+      {
+        return async_shared_mutex_lock(*m_mutex, false);
+      }
+
+    private:
+      async_shared_mutex* m_mutex;
+  };
+} // namespace __details
+
+/**
+ * Reader-writer lock for coroutines, made for read-mostly data (e.g. routing
+ * tables). Taking the shared lock is a single atomic add while no writer is
+ * around. Writers queue in FIFO order and stop new readers, thus they aren't
+ * starved: a writer waits only for the readers that were already inside.
+ * The readers that came meanwhile are continued together when the writer
+ * unlocks, before the next writer gets the lock.
+ *
+ * The state is the number of readers and a writer flag in one atomic word.
+ * Readers that find the flag set stay counted and wait, the writer knows
+ * from the count how many of them it has to let in when it unlocks.
+ * Therefore the waiters aren't cancelled by a stop request, a reader that
+ * left would still be counted.
+ *
+ * cf::async_shared_mutex mutex;
+ * {
+ *   auto lock = co_await mutex.lock_shared();
+ *   ...
+ * }
+ */
+class async_shared_mutex
+{
+    friend class __details::async_shared_mutex_lock_shared_awaitable_t;
+    friend class __details::async_shared_mutex_lock_awaitable_t;
+    using reader_t = __details::async_shared_mutex_lock_shared_awaitable_t;
+    using writer_t = __details::async_shared_mutex_lock_awaitable_t;
+
+    static constexpr std::uint64_t c_writer = std::uint64_t{ 1 } << 32;
+    static constexpr std::uint64_t c_readers_mask = c_writer - 1;
+
+  public:
+    async_shared_mutex() = default;
+    async_shared_mutex(const async_shared_mutex&) = delete;
+    async_shared_mutex& operator=(const async_shared_mutex&) = delete;
+    ~async_shared_mutex()
+    {
+      assert(m_state.load(std::memory_order_relaxed) == 0 &&
+             m_writer_locked == false);
+    }
+
+    // co_await returns an async_shared_mutex_lock
+    reader_t lock_shared() noexcept { return reader_t(*this); }
+    writer_t lock() noexcept { return writer_t(*this); }
+
+    bool try_lock_shared() noexcept
+    {
+      std::uint64_t state = m_state.load(std::memory_order_relaxed);
+      while ((state & c_writer) == 0)
+      {
+        if (m_state.compare_exchange_weak(state,
+                                          state + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    bool try_lock()
+    {
+      std::lock_guard lock(m_mutex);
+      std::uint64_t expected = 0;
+      if (m_writer_locked ||
+          m_state.compare_exchange_strong(expected,
+                                          c_writer,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed) == false)
+      {
+        return false;
+      }
+      m_writer_locked = true;
+      return true;
+    }
+
+    void unlock_shared()
+    {
+      const std::uint64_t state =
+          m_state.fetch_sub(1, std::memory_order_release);
+      assert((state & c_readers_mask) != 0);
+      if ((state & c_writer) != 0 &&
+          m_departing_readers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        // The last reader that was inside when the writer came
+        CF_PROFILE_SCOPE();
+        std::exchange(m_draining_writer, nullptr)->resume();
+      }
+    }
+    void unlock()
+    {
+      CF_PROFILE_SCOPE();
+      // New readers can enter, the ones that came meanwhile are let in
+      const std::uint64_t state =
+          m_state.fetch_sub(c_writer, std::memory_order_release);
+      assert((state & c_writer) != 0);
+      std::uint64_t waiting_readers = state & c_readers_mask;
+      __details::waiter_queue_t resumed;
+      {
+        std::lock_guard lock(m_mutex);
+        for (; waiting_readers > 0 && m_readers.empty() == false;
+             --waiting_readers)
+        {
+          resumed.push_back(m_readers.pop_front());
+        }
+        // The rest haven't reached the queue yet
+        m_reader_grants += waiting_readers;
+        if (m_writers.empty())
+        {
+          m_writer_locked = false;
+        }
+        else
+        {
+          auto* writer = static_cast<writer_t*>(m_writers.pop_front());
+          if (begin_write(writer))
+          {
+            resumed.push_back(writer);
+          }
+        }
+      }
+      resumed.resume_all();
+    }
+
+  private:
+    /**
+     * Stops the new readers and returns true when no reader is inside.
+     * Otherwise the writer is continued by the last leaving reader. Called
+     * under m_mutex by the writer that owns m_writer_locked.
+     */
+    bool begin_write(writer_t* writer)
+    {
+      m_draining_writer = writer;
+      const std::uint64_t readers =
+          m_state.fetch_add(c_writer, std::memory_order_acquire) &
+          c_readers_mask;
+      // The readers might have left already, then the counter is negative
+      if (readers == 0 ||
+          m_departing_readers.fetch_add(static_cast<std::int64_t>(readers),
+                                        std::memory_order_acq_rel) +
+                  static_cast<std::int64_t>(readers) ==
+              0)
+      {
+        m_draining_writer = nullptr;
+        return true;
+      }
+      return false;
+    }
+
+    std::atomic_uint64_t m_state{ 0 };
+    // Readers that have to leave before the draining writer gets the lock
+    std::atomic_int64_t m_departing_readers{ 0 };
+    writer_t* m_draining_writer{ nullptr };
+
+    // Guards the slow paths
+    std::mutex m_mutex;
+    bool m_writer_locked{ false };
+    // Readers that were let in by a writer but didn't reach the queue yet
+    std::uint64_t m_reader_grants{ 0 };
+    __details::waiter_queue_t m_readers;
+    __details::waiter_queue_t m_writers;
+};
+
+inline void async_shared_mutex_lock::unlock()
+{
+  if (m_mutex != nullptr)
+  {
+    if (m_shared)
+    {
+      std::exchange(m_mutex, nullptr)->unlock_shared();
+    }
+    else
+    {
+      std::exchange(m_mutex, nullptr)->unlock();
+    }
+  }
+}
+
+namespace __details
+{
+  inline bool async_shared_mutex_lock_shared_awaitable_t::await_ready() noexcept
+  {
+    // The reader is counted even if it has to wait for a writer
+    return (m_mutex->m_state.fetch_add(1, std::memory_order_acquire) &
+            async_shared_mutex::c_writer) == 0;
+  }
+  inline bool async_shared_mutex_lock_shared_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    std::lock_guard lock(m_mutex->m_mutex);
+    if (m_mutex->m_reader_grants > 0)
+    {
+      --m_mutex->m_reader_grants;
+      return false;
+    }
+    this->suspended_task.emplace(std::move(suspended_task));
+    m_mutex->m_readers.push_back(this);
+    return true;
+  }
+
+  inline bool async_shared_mutex_lock_awaitable_t::await_ready()
+  {
+    return m_mutex->try_lock();
+  }
+  inline bool async_shared_mutex_lock_awaitable_t::await_suspend(
+      suspended_task_t suspended_task)
+  {
+    CF_PROFILE_SCOPE();
+    std::lock_guard lock(m_mutex->m_mutex);
+    // Stored before it's visible to the readers that might resume it
+    this->suspended_task.emplace(std::move(suspended_task));
+    if (m_mutex->m_writer_locked)
+    {
+      m_mutex->m_writers.push_back(this);
+      return true;
+    }
+    m_mutex->m_writer_locked = true;
+    if (m_mutex->begin_write(this))
+    {
+      this->suspended_task.reset();
+      return false;
+    }
+    return true;
+  }
+} // namespace __details
+} // namespace coroutine_flow
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  constexpr const std::size_t c_blocking_pool_max_threads = 64;
+
+  inline schedulers::elastic_thread_pool_t& default_blocking_pool()
+  {
+    static schedulers::elastic_thread_pool_t pool(
+        { .min_threads = 0,
+          .max_threads = c_blocking_pool_max_threads,
+          .idle_timeout = std::chrono::seconds{ 10 } });
+    return pool;
+  }
+
+  template <typename callable_t, task_scheduler scheduler_t>
+  class blocking_awaitable_t
+  {
+      using result_t = std::invoke_result_t<callable_t&>;
+      static_assert(std::is_reference_v<result_t> == false,
+                    "Blocking operation can't return a reference.");
+      using stored_result_t = std::conditional_t<std::is_void_v<result_t>,
+                                                 std::monostate,
+                                                 result_t>;
+
+    public:
+      blocking_awaitable_t(callable_t callable, scheduler_t scheduler)
+          : m_callable(std::move(callable))
+          , m_scheduler(std::move(scheduler))
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        const schedule_hints_t hints = suspended_task.hints();
+        schedule_task(
+            m_scheduler,
+            [this, p_suspended_task = std::move(suspended_task)]() mutable
+            {
+              CF_PROFILE_SCOPE_N("blocking_awaitable_t::execute");
+              execute();
+              // Hop back to the scheduler of the coroutine
+              p_suspended_task.resume();
+            },
+            hints);
+      }
+      result_t await_resume()
+      {
+        if (m_exception)
+        {
+          std::rethrow_exception(m_exception);
+        }
+        if constexpr (std::is_void_v<result_t> == false)
+        {
+          return std::move(*m_result);
+        }
+      }
+
+    private:
+      void execute() noexcept
+      {
+        try
+        {
+          if constexpr (std::is_void_v<result_t>)
+          {
+            std::invoke(m_callable);
+            m_result.emplace();
+          }
+          else
+          {
+            m_result.emplace(std::invoke(m_callable));
+          }
+        }
+        catch (...)
+        {
+          m_exception = std::current_exception();
+        }
+      }
+
+      callable_t m_callable;
+      scheduler_t m_scheduler;
+      std::optional<stored_result_t> m_result;
+      std::exception_ptr m_exception;
+  };
+} // namespace __details
+
+/**
+ * Executes a blocking operation (syscall, legacy library, etc.) on a
+ * dedicated, bounded and growable pool. The awaiting coroutine is continued
+ * on its own scheduler with the result, thus blocking work never occupies the
+ * workers of the coroutines.
+ *
+ * co_await cf::blocking([] { return read(fd, buffer, size); });
+ */
+template <std::invocable callable_t>
+auto blocking(callable_t&& callable)
+{
+  return __details::blocking_awaitable_t<std::decay_t<callable_t>,
+                                         schedulers::elastic_thread_pool_t*>(
+      std::forward<callable_t>(callable),
+      &__details::default_blocking_pool());
+}
+
+// Same as above but the blocking operation is executed on the given scheduler
+template <std::invocable callable_t, task_scheduler scheduler_t>
+auto blocking(callable_t&& callable, scheduler_t scheduler)
+{
+  return __details::blocking_awaitable_t<std::decay_t<callable_t>,
+                                         scheduler_t>(
+      std::forward<callable_t>(callable),
+      std::move(scheduler));
+}
+} // namespace coroutine_flow
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+namespace coroutine_flow
+{
+/**
+ * The stop token of the coroutine tree (see run_async with a stop token).
+ * Long running coroutines can poll it or register a std::stop_callback. When
+ * the tree was started without a token it's not stop_possible.
+ *
+ * std::stop_token stop_token = co_await cf::get_stop_token();
+ */
+inline __details::get_stop_token_t get_stop_token() noexcept { return {}; }
+} // namespace coroutine_flow
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <coroutine_flow/__details/bounded_ring.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/waiter_queue.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace coroutine_flow
+{
+enum class channel_kind
+{
+  // Any number of coroutines send and receive
+  mpmc,
+  // One coroutine sends and one receives at a time (1:1 pipeline stages)
+  spsc
+};
+
+namespace __details
+{
+  template <typename channel_t>
+  class channel_send_awaitable_t : public waiter_node_t
+  {
+      friend channel_t;
+      using value_t = typename channel_t::value_type;
+
+    public:
+      channel_send_awaitable_t(channel_t& channel, value_t value)
+          : m_channel(&channel)
+          , m_value(std::move(value))
+      {
+      }
+
+      bool await_ready()
+      {
+        m_sent = m_channel->try_send(std::move(m_value));
+        return m_sent || m_channel->is_closed();
+      }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        enable_cancellation(suspended_task.context().stop_token,
+                            &channel_t::cancel_sender);
+        return m_channel->send_or_wait(*this, std::move(suspended_task));
+      }
+      // Returns false when the channel is closed, the value is dropped
+      bool await_resume()
+      {
+        finish_waiting();
+        return m_sent;
+      }
+
+    private:
+      channel_t* m_channel;
+      value_t m_value;
+      bool m_sent{ false };
+  };
+
+  template <typename channel_t>
+  class channel_receive_awaitable_t : public waiter_node_t
+  {
+      friend channel_t;
+      using value_t = typename channel_t::value_type;
+
+    public:
+      explicit channel_receive_awaitable_t(channel_t& channel) noexcept
+          : m_channel(&channel)
+      {
+      }
+
+      bool await_ready()
+      {
+        m_value = m_channel->try_receive();
+        return m_value.has_value() || m_channel->is_closed();
+      }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        enable_cancellation(suspended_task.context().stop_token,
+                            &channel_t::cancel_receiver);
+        return m_channel->receive_or_wait(*this, std::move(suspended_task));
+      }
+      // Returns nullopt when the channel is closed and drained
+      std::optional<value_t> await_resume()
+      {
+        finish_waiting();
+        return std::move(m_value);
+      }
+
+    private:
+      channel_t* m_channel;
+      std::optional<value_t> m_value;
+  };
+} // namespace __details
+
+/**
+ * Bounded channel between coroutines, e.g. stages of a pipeline. Sending to
+ * a full channel suspends the sender until there is room (backpressure),
+ * receiving from an empty one suspends the receiver until a value comes. The
+ * counterpart that makes progress possible hands the value over and resumes
+ * the suspended one on its own scheduler.
+ *
+ * The values are stored in a lock-free ring buffer, try_send/try_receive and
+ * the awaitables use it directly while nobody waits. The waiters are linked
+ * into queues through their awaiters under a short lock. Each side registers
+ * itself as waiting before it checks the ring again and the other side
+ * checks the registrations after it accessed the ring (both with a full
+ * fence), thus a wakeup can't be missed.
+ *
+ * After close the sends fail, the receivers get the buffered values and then
+ * nullopt. A waiting sender or receiver whose stop is requested leaves the
+ * queue with operation_cancelled_error, the value of a sender is dropped.
+ *
+ * cf::channel<int> channel(64);
+ * co_await channel.send(42);
+ * std::optional<int> value = co_await channel.receive();
+ */
+template <typename T, channel_kind kind = channel_kind::mpmc>
+class channel
+{
+    using send_awaitable_t = __details::channel_send_awaitable_t<channel>;
+    using receive_awaitable_t =
+        __details::channel_receive_awaitable_t<channel>;
+    friend send_awaitable_t;
+    friend receive_awaitable_t;
+    using ring_t = std::conditional_t<kind == channel_kind::spsc,
+                                      __details::spsc_ring_t<T>,
+                                      __details::mpmc_ring_t<T>>;
+
+  public:
+    using value_type = T;
+
+    explicit channel(std::size_t capacity)
+        : m_ring(capacity)
+    {
+    }
+    channel(const channel&) = delete;
+    channel& operator=(const channel&) = delete;
+    ~channel() { assert(m_senders.empty() && m_receivers.empty()); }
+
+    // co_await returns false when the channel is closed
+    send_awaitable_t send(T value)
+    {
+      return send_awaitable_t(*this, std::move(value));
+    }
+    // co_await returns nullopt when the channel is closed and drained
+    receive_awaitable_t receive() noexcept
+    {
+      return receive_awaitable_t(*this);
+    }
+
+    // The value is moved from only when it's sent
+    template <typename U>
+    bool try_send(U&& value)
+    {
+      if (is_closed() || m_ring.try_push(std::forward<U>(value)) == false)
+      {
+        return false;
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (m_waiting_receivers.load(std::memory_order_relaxed) != 0)
+      {
+        resume(lock_and_take_receiver());
+      }
+      return true;
+    }
+    std::optional<T> try_receive()
+    {
+      std::optional<T> result = m_ring.try_pop();
+      if (result.has_value())
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting_senders.load(std::memory_order_relaxed) != 0)
+        {
+          resume(lock_and_take_sender());
+        }
+      }
+      return result;
+    }
+
+    void close()
+    {
+      CF_PROFILE_SCOPE();
+      __details::waiter_queue_t resumed;
+      {
+        std::lock_guard lock(m_mutex);
+        m_closed.store(true, std::memory_order_release);
+        while (m_senders.empty() == false)
+        {
+          resumed.push_back(m_senders.pop_front());
+        }
+        while (m_receivers.empty() == false)
+        {
+          auto* receiver = static_cast<receive_awaitable_t*>(
+              m_receivers.pop_front());
+          // A value might have been sent while the receiver registered
+          receiver->m_value = m_ring.try_pop();
+          resumed.push_back(receiver);
+        }
+        m_waiting_senders.store(0, std::memory_order_relaxed);
+        m_waiting_receivers.store(0, std::memory_order_relaxed);
+      }
+      resumed.resume_all();
+    }
+    bool is_closed() const noexcept
+    {
+      return m_closed.load(std::memory_order_acquire);
+    }
+
+  private:
+    // Returns true when the sender waits for room
+    bool send_or_wait(send_awaitable_t& sender,
+                      __details::suspended_task_t suspended_task)
+    {
+      CF_PROFILE_SCOPE();
+      receive_awaitable_t* receiver = nullptr;
+      {
+        std::lock_guard lock(m_mutex);
+        if (sender.cancelled())
+        {
+          return false;
+        }
+        m_waiting_senders.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (is_closed() == false &&
+            m_ring.try_push(std::move(sender.m_value)) == false)
+        {
+          sender.suspended_task.emplace(std::move(suspended_task));
+          sender.state = __details::waiter_node_t::state_t::waiting;
+          m_senders.push_back(&sender);
+          return true;
+        }
+        m_waiting_senders.fetch_sub(1, std::memory_order_relaxed);
+        sender.state = __details::waiter_node_t::state_t::finished;
+        sender.m_sent = is_closed() == false;
+        receiver = take_receiver();
+      }
+      resume(receiver);
+      return false;
+    }
+    // Returns true when the receiver waits for a value
+    bool receive_or_wait(receive_awaitable_t& receiver,
+                         __details::suspended_task_t suspended_task)
+    {
+      CF_PROFILE_SCOPE();
+      send_awaitable_t* sender = nullptr;
+      {
+        std::lock_guard lock(m_mutex);
+        if (receiver.cancelled())
+        {
+          return false;
+        }
+        m_waiting_receivers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        receiver.m_value = m_ring.try_pop();
+        if (receiver.m_value.has_value() == false && is_closed() == false)
+        {
+          receiver.suspended_task.emplace(std::move(suspended_task));
+          receiver.state = __details::waiter_node_t::state_t::waiting;
+          m_receivers.push_back(&receiver);
+          return true;
+        }
+        m_waiting_receivers.fetch_sub(1, std::memory_order_relaxed);
+        receiver.state = __details::waiter_node_t::state_t::finished;
+        sender = take_sender();
+      }
+      resume(sender);
+      return false;
+    }
+
+    // Moves the value of the first waiting sender into the ring
+    send_awaitable_t* take_sender()
+    {
+      if (m_senders.empty())
+      {
+        return nullptr;
+      }
+      auto* sender = static_cast<send_awaitable_t*>(m_senders.front());
+      if (m_ring.try_push(std::move(sender->m_value)) == false)
+      {
+        return nullptr;
+      }
+      m_senders.pop_front();
+      m_waiting_senders.fetch_sub(1, std::memory_order_relaxed);
+      sender->m_sent = true;
+      return sender;
+    }
+    // Hands a value of the ring over to the first waiting receiver
+    receive_awaitable_t* take_receiver()
+    {
+      if (m_receivers.empty())
+      {
+        return nullptr;
+      }
+      std::optional<T> value = m_ring.try_pop();
+      if (value.has_value() == false)
+      {
+        return nullptr;
+      }
+      auto* receiver =
+          static_cast<receive_awaitable_t*>(m_receivers.pop_front());
+      m_waiting_receivers.fetch_sub(1, std::memory_order_relaxed);
+      receiver->m_value = std::move(value);
+      return receiver;
+    }
+    send_awaitable_t* lock_and_take_sender()
+    {
+      std::lock_guard lock(m_mutex);
+      return take_sender();
+    }
+    receive_awaitable_t* lock_and_take_receiver()
+    {
+      std::lock_guard lock(m_mutex);
+      return take_receiver();
+    }
+    // Stop handlers of the waiters, the unlinked waiter throws when resumed
+    static void cancel_sender(__details::waiter_node_t& waiter)
+    {
+      channel* self = static_cast<send_awaitable_t&>(waiter).m_channel;
+      {
+        std::lock_guard lock(self->m_mutex);
+        if (self->m_senders.cancel(&waiter) == false)
+        {
+          return;
+        }
+        self->m_waiting_senders.fetch_sub(1, std::memory_order_relaxed);
+      }
+      waiter.resume();
+    }
+    static void cancel_receiver(__details::waiter_node_t& waiter)
+    {
+      channel* self = static_cast<receive_awaitable_t&>(waiter).m_channel;
+      {
+        std::lock_guard lock(self->m_mutex);
+        if (self->m_receivers.cancel(&waiter) == false)
+        {
+          return;
+        }
+        self->m_waiting_receivers.fetch_sub(1, std::memory_order_relaxed);
+      }
+      waiter.resume();
+    }
+    static void resume(__details::waiter_node_t* waiter)
+    {
+      if (waiter != nullptr)
+      {
+        waiter->resume();
+      }
+    }
+
+    ring_t m_ring;
+    std::atomic_bool m_closed{ false };
+    // Registered under the lock, read without it by the fast paths
+    std::atomic_size_t m_waiting_senders{ 0 };
+    std::atomic_size_t m_waiting_receivers{ 0 };
+    std::mutex m_mutex;
+    __details::waiter_queue_t m_senders;
+    __details::waiter_queue_t m_receivers;
+};
+
+// For 1:1 pipeline stages, the ring is accessed without read-modify-writes
+template <typename T>
+using spsc_channel = channel<T, channel_kind::spsc>;
+} // namespace coroutine_flow
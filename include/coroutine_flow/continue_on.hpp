@@ -0,0 +1,54 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <utility>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  template <task_scheduler scheduler_t>
+  class continue_on_awaitable_t
+  {
+    public:
+      explicit continue_on_awaitable_t(scheduler_t scheduler)
+          : m_scheduler(std::move(scheduler))
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        suspended_task.resume_on(m_scheduler);
+      }
+      void await_resume() const noexcept {}
+
+    private:
+      scheduler_t m_scheduler;
+  };
+} // namespace __details
+
+/**
+ * Moves the coroutine to another scheduler: the rest of its body and every
+ * coroutine that it co_awaits afterwards is executed there. The hop costs
+ * one schedule on the target scheduler. The hints of the coroutine are kept.
+ * The awaiting coroutine is not moved, it's continued on its own scheduler
+ * (another schedule) when this coroutine is finished.
+ *
+ * co_await cf::continue_on(&io_pool);
+ * auto data = co_await read_data();
+ * co_await cf::continue_on(&cpu_pool);
+ * co_return process(data);
+ */
+template <task_scheduler scheduler_t>
+__details::continue_on_awaitable_t<scheduler_t>
+    continue_on(scheduler_t scheduler)
+{
+  return __details::continue_on_awaitable_t<scheduler_t>(std::move(scheduler));
+}
+} // namespace coroutine_flow
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <coroutine_flow/tag_invoke.hpp>
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+
+struct schedule_task_t
+{
+};
+
+/**
+ * Hands over a batch of tasks with the same hints at once, e.g. under one
+ * lock: tag_invoke(schedule_bulk_t, scheduler, callbacks, hints). Either every
+ * task is scheduled or none of them (when it throws). Schedulers without it
+ * receive the tasks one by one.
+ */
+struct schedule_bulk_t
+{
+};
+
+/**
+ * Lends the queue of a scheduler to a thread that waits for a result (e.g.
+ * sync_wait): tag_invoke(run_pending_task_t, scheduler, ready) executes one
+ * queued task on the calling thread. It waits for a task until stop is
+ * requested on the ready token (the result is set), then it returns without
+ * executing anything. It returns false when the calling thread can't help
+ * (e.g. it is not a worker of the scheduler), then the caller blocks instead.
+ */
+struct run_pending_task_t
+{
+};
+
+/**
+ * Schedules a task that must not start before the given time point:
+ * tag_invoke(schedule_at_t, scheduler, callback, time_point, hints). Event
+ * loop schedulers can implement it with their native timers. Schedulers
+ * without it (and without schedule_after_t) get the task from the timer
+ * thread of the library when it's due.
+ */
+struct schedule_at_t
+{
+};
+
+/**
+ * Same as schedule_at_t with a relative delay:
+ * tag_invoke(schedule_after_t, scheduler, callback, duration, hints).
+ * schedule_at_t is preferred when a scheduler implements both.
+ */
+struct schedule_after_t
+{
+};
+
+enum class priority_t : std::uint8_t
+{
+  low,
+  normal,
+  high,
+  critical
+};
+constexpr const std::size_t c_priority_levels = 4;
+
+using deadline_clock_t = std::chrono::steady_clock;
+using deadline_t = deadline_clock_t::time_point;
+constexpr const deadline_t c_no_deadline = deadline_t::max();
+
+// Identifies a tenant or any other group of tasks that shares a fair share
+enum class group_id_t : std::uint64_t
+{
+};
+constexpr const group_id_t c_default_group{ 0 };
+
+/**
+ * Extra information that travels together with a task when it is handed over
+ * to the scheduler. It is set when the top level coroutine is started
+ * (run_async/sync_wait) and every co_awaited coroutine inherits it from its
+ * parent. Schedulers that don't care about it can ignore it: the plain
+ * tag_invoke(schedule_task_t, scheduler, callback) is used for them.
+ */
+struct schedule_hints_t
+{
+    priority_t priority{ priority_t::normal };
+    deadline_t deadline{ c_no_deadline };
+    group_id_t group{ c_default_group };
+
+    schedule_hints_t() = default;
+    explicit(false) schedule_hints_t(priority_t priority)
+        : priority(priority)
+    {
+    }
+    explicit(false) schedule_hints_t(deadline_t deadline)
+        : deadline(deadline)
+    {
+    }
+    explicit(false) schedule_hints_t(group_id_t group)
+        : group(group)
+    {
+    }
+
+    bool has_deadline() const { return deadline != c_no_deadline; }
+    bool operator==(const schedule_hints_t&) const = default;
+};
+
+/**
+ * The coroutine was shed by its scheduler because it already missed its
+ * deadline before it could start. The coroutine body is not executed, the
+ * error is propagated to its awaiter.
+ */
+struct deadline_exceeded_error : std::runtime_error
+{
+    deadline_exceeded_error()
+        : std::runtime_error("The deadline of the task is exceeded.")
+    {
+    }
+};
+
+/**
+ * Stop was requested for the coroutine tree (see run_async with a
+ * std::stop_token). Coroutines that would start afterwards and the library
+ * awaitables that are suspended (e.g. sleep_for) finish with this error, thus
+ * the tree is unwound without running the rest of its work.
+ */
+struct operation_cancelled_error : std::runtime_error
+{
+    operation_cancelled_error()
+        : std::runtime_error("The operation is cancelled.")
+    {
+    }
+};
+
+template <typename scheduler_t>
+concept hinted_scheduler = is_tag_invocable<schedule_task_t,
+                                            scheduler_t,
+                                            std::function<void()>,
+                                            const schedule_hints_t&>;
+
+template <typename scheduler_t>
+concept task_scheduler =
+    std::copyable<scheduler_t> &&
+    (is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>> ||
+     hinted_scheduler<scheduler_t>);
+
+template <typename scheduler_t>
+concept bulk_scheduler =
+    is_tag_invocable<schedule_bulk_t,
+                     scheduler_t,
+                     std::vector<std::function<void()>>,
+                     const schedule_hints_t&>;
+
+template <typename scheduler_t>
+concept drivable_scheduler =
+    is_tag_invocable<run_pending_task_t, scheduler_t, std::stop_token>;
+
+using timer_clock_t = std::chrono::steady_clock;
+
+template <typename scheduler_t>
+concept schedule_at_scheduler = is_tag_invocable<schedule_at_t,
+                                                 scheduler_t,
+                                                 std::function<void()>,
+                                                 timer_clock_t::time_point,
+                                                 const schedule_hints_t&>;
+
+template <typename scheduler_t>
+concept schedule_after_scheduler =
+    is_tag_invocable<schedule_after_t,
+                     scheduler_t,
+                     std::function<void()>,
+                     timer_clock_t::duration,
+                     const schedule_hints_t&>;
+
+namespace __details
+{
+  /**
+   * Callback that starts a coroutine. Schedulers can shed it (see try_shed)
+   * instead of executing the work behind it: the coroutine is finished with
+   * deadline_exceeded_error without running its body.
+   */
+  struct start_callback_t
+  {
+      std::function<void()> callback;
+      // Flag of the started coroutine, it's checked when its body would begin
+      bool* shed_requested;
+
+      void operator()() const { callback(); }
+  };
+  /**
+   * Marks the coroutine that the callback would start as shed, the callback
+   * still has to be executed. Returns false for the callbacks that continue
+   * an already started coroutine (or aren't coroutines), they are executed as
+   * usual.
+   */
+  inline bool try_shed(std::function<void()>& callback) noexcept
+  {
+    start_callback_t* start = callback.target<start_callback_t>();
+    if (start == nullptr)
+    {
+      return false;
+    }
+    *start->shed_requested = true;
+    return true;
+  }
+
+  template <task_scheduler scheduler_t>
+  void schedule_task(const scheduler_t& scheduler,
+                     std::function<void()> callback,
+                     const schedule_hints_t& hints)
+  {
+    if constexpr (hinted_scheduler<scheduler_t>)
+    {
+      tag_invoke(schedule_task_t{}, scheduler, std::move(callback), hints);
+    }
+    else
+    {
+      tag_invoke(schedule_task_t{}, scheduler, std::move(callback));
+    }
+  }
+
+  // Worker pool of the current thread, a worker can help only its own pool
+  inline const void*& current_worker_owner() noexcept
+  {
+    thread_local const void* value = nullptr;
+    return value;
+  }
+} // namespace __details
+} // namespace coroutine_flow
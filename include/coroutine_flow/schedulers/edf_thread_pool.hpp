@@ -0,0 +1,177 @@
+#pragma once
+
+#include <coroutine_flow/__details/worker_pool.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+namespace coroutine_flow
+{
+enum class deadline_miss_policy_t
+{
+  // Late tasks are still executed, they are only counted.
+  execute,
+  // Coroutines that would start after their deadline are finished with
+  // deadline_exceeded_error without executing their body.
+  shed
+};
+
+namespace __details
+{
+  /**
+   * Earliest deadline first queue. Tasks without deadline are ordered after
+   * every task with deadline. Equal deadlines are served in FIFO order.
+   */
+  class edf_queue_t
+  {
+    public:
+      struct statistics_t
+      {
+          std::atomic_uint64_t missed{ 0 };
+          std::atomic_uint64_t shed{ 0 };
+      };
+
+      edf_queue_t(deadline_miss_policy_t policy, statistics_t& statistics)
+          : m_policy(policy)
+          , m_statistics(statistics)
+      {
+      }
+
+      void push(std::function<void()> callback,
+                const schedule_hints_t& hints,
+                worker_clock_t::time_point)
+      {
+        m_entries.push_back(
+            { std::move(callback), hints.deadline, m_next_sequence++ });
+        std::ranges::push_heap(m_entries, later_t{});
+      }
+      void push_bulk(std::vector<std::function<void()>>& callbacks,
+                     const schedule_hints_t& hints,
+                     worker_clock_t::time_point)
+      {
+        // Only the reservation can throw
+        m_entries.reserve(m_entries.size() + callbacks.size());
+        for (auto& callback : callbacks)
+        {
+          m_entries.push_back(
+              { std::move(callback), hints.deadline, m_next_sequence++ });
+          std::ranges::push_heap(m_entries, later_t{});
+        }
+      }
+
+      std::optional<std::function<void()>> pop(worker_clock_t::time_point now)
+      {
+        if (m_entries.empty())
+        {
+          return std::nullopt;
+        }
+        std::ranges::pop_heap(m_entries, later_t{});
+        entry_t entry = std::move(m_entries.back());
+        m_entries.pop_back();
+
+        if (entry.deadline >= now)
+        {
+          return std::move(entry.callback);
+        }
+        m_statistics.missed.fetch_add(1, std::memory_order_relaxed);
+        // The shed is read by the worker that executes the callback
+        if (m_policy == deadline_miss_policy_t::shed &&
+            __details::try_shed(entry.callback))
+        {
+          m_statistics.shed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return std::move(entry.callback);
+      }
+
+      bool empty() const { return m_entries.empty(); }
+      std::size_t size() const { return m_entries.size(); }
+
+    private:
+      struct entry_t
+      {
+          std::function<void()> callback;
+          deadline_t deadline;
+          std::uint64_t sequence;
+      };
+      // std heap is a max heap, the 'largest' is the earliest deadline
+      struct later_t
+      {
+          bool operator()(const entry_t& lhs, const entry_t& rhs) const
+          {
+            if (lhs.deadline != rhs.deadline)
+            {
+              return lhs.deadline > rhs.deadline;
+            }
+            return lhs.sequence > rhs.sequence;
+          }
+      };
+
+      std::vector<entry_t> m_entries;
+      std::uint64_t m_next_sequence{ 0 };
+      deadline_miss_policy_t m_policy;
+      statistics_t& m_statistics;
+  };
+} // namespace __details
+
+namespace schedulers
+{
+  /**
+   * Thread pool that executes the tasks in earliest deadline first order. The
+   * deadline is set at run_async/sync_wait and inherited by every co_awaited
+   * coroutine.
+   */
+  class edf_thread_pool_t
+  {
+    public:
+      explicit edf_thread_pool_t(
+          std::size_t thread_count,
+          deadline_miss_policy_t policy = deadline_miss_policy_t::execute)
+          : m_pool(thread_count, policy, m_statistics)
+      {
+      }
+
+      // Number of tasks that were picked up after their deadline
+      std::uint64_t missed_count() const
+      {
+        return m_statistics.missed.load(std::memory_order_relaxed);
+      }
+      // Number of coroutines that were not started because of a missed
+      // deadline
+      std::uint64_t shed_count() const
+      {
+        return m_statistics.shed.load(std::memory_order_relaxed);
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             edf_thread_pool_t* pool,
+                             std::function<void()> callback,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push(std::move(callback), hints);
+      }
+      friend void tag_invoke(schedule_bulk_t,
+                             edf_thread_pool_t* pool,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push_bulk(std::move(callbacks), hints);
+      }
+      friend bool tag_invoke(run_pending_task_t,
+                             edf_thread_pool_t* pool,
+                             std::stop_token ready)
+      {
+        return pool->m_pool.run_pending(std::move(ready));
+      }
+
+    private:
+      __details::edf_queue_t::statistics_t m_statistics;
+      __details::worker_pool_t<__details::edf_queue_t> m_pool;
+  };
+} // namespace schedulers
+} // namespace coroutine_flow
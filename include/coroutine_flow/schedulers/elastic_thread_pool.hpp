@@ -0,0 +1,396 @@
+#pragma once
+
+#include <coroutine_flow/__details/timer_service.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace coroutine_flow
+{
+struct elastic_pool_options_t
+{
+    std::size_t min_threads{ 0 };
+    std::size_t max_threads{
+      std::max(1u, std::thread::hardware_concurrency())
+    };
+    // A worker that doesn't find any task for this long is retired, unless
+    // the pool would shrink below min_threads.
+    std::chrono::nanoseconds idle_timeout{ std::chrono::seconds{ 5 } };
+    // A new worker is spawned when this many tasks are waiting without an
+    // idle worker...
+    std::size_t spawn_queue_depth{ 1 };
+    // ...or when the oldest waiting task is waiting at least this long.
+    std::chrono::nanoseconds spawn_latency{ std::chrono::milliseconds{ 1 } };
+};
+
+struct elastic_pool_metrics_t
+{
+    std::size_t thread_count{ 0 };
+    std::size_t idle_count{ 0 };
+    std::size_t peak_thread_count{ 0 };
+    std::size_t queue_depth{ 0 };
+    // Scaling events since the construction of the pool
+    std::uint64_t spawned{ 0 };
+    std::uint64_t retired{ 0 };
+};
+
+namespace schedulers
+{
+  /**
+   * FIFO thread pool that grows and shrinks with the demand. Workers are
+   * spawned lazily when the queue is getting deeper or the tasks are waiting
+   * too long, and the idle ones are retired after a timeout. The number of
+   * the workers stays between min_threads and max_threads. While tasks wait
+   * without an idle worker, the waiting time is checked by the timer thread
+   * of the library, thus it's noticed even if every worker is busy.
+   *
+   * The queued tasks might continue suspended coroutines, thus the
+   * destruction of the pool waits until the workers drained the queue. No
+   * worker is spawned meanwhile, the queue is drained by the destroying
+   * thread when there is no worker left.
+   */
+  class elastic_thread_pool_t
+  {
+    public:
+      explicit elastic_thread_pool_t(elastic_pool_options_t options = {})
+          : m_options(options)
+          , m_latency_check(std::make_shared<latency_check_t>(this))
+      {
+        m_options.max_threads =
+            std::max<std::size_t>(m_options.max_threads, 1);
+        m_options.min_threads =
+            std::min(m_options.min_threads, m_options.max_threads);
+        std::lock_guard lock(m_mutex);
+        for (std::size_t i = 0; i < m_options.min_threads; ++i)
+        {
+          spawn_worker();
+        }
+      }
+      elastic_thread_pool_t(const elastic_thread_pool_t&) = delete;
+      elastic_thread_pool_t(elastic_thread_pool_t&&) = delete;
+
+      elastic_thread_pool_t& operator=(const elastic_thread_pool_t&) = delete;
+      elastic_thread_pool_t& operator=(elastic_thread_pool_t&&) = delete;
+
+      ~elastic_thread_pool_t()
+      {
+        {
+          // Waits for the check that might be running on the timer thread
+          std::lock_guard lock(m_latency_check->mutex);
+          m_latency_check->pool = nullptr;
+        }
+        std::list<std::jthread> workers;
+        {
+          std::lock_guard lock(m_mutex);
+          if (m_latency_check_armed)
+          {
+            __details::timer_service_t::instance().cancel(
+                m_latency_check_timer);
+          }
+          m_stop_requested = true;
+          workers.splice(workers.end(), m_workers);
+          workers.splice(workers.end(), m_retired_workers);
+        }
+        m_condition.notify_all();
+        // The workers drain the queue before they stop
+        workers.clear();
+        // Nobody was left to drain it, e.g. no worker could be spawned
+        std::unique_lock lock(m_mutex);
+        while (m_queue.empty() == false)
+        {
+          execute_next(lock);
+        }
+      }
+
+      void push(std::function<void()> callback)
+      {
+        // The retired workers are joined outside of the lock, they are
+        // already finished or about to finish.
+        std::list<std::jthread> retired_workers;
+        {
+          std::lock_guard lock(m_mutex);
+          const auto now = worker_clock_t::now();
+          m_queue.push_back({ std::move(callback), now });
+          try
+          {
+            scale_up_if_needed(now);
+          }
+          catch (...)
+          {
+            m_queue.pop_back();
+            throw;
+          }
+          retired_workers.swap(m_retired_workers);
+        }
+        m_condition.notify_one();
+      }
+
+      void push_bulk(std::vector<std::function<void()>> callbacks)
+      {
+        std::list<std::jthread> retired_workers;
+        {
+          std::lock_guard lock(m_mutex);
+          const auto now = worker_clock_t::now();
+          const std::size_t queue_size = m_queue.size();
+          try
+          {
+            for (auto& callback : callbacks)
+            {
+              m_queue.push_back({ std::move(callback), now });
+            }
+            // One worker is spawned at a time, the others are spawned by the
+            // workers that find the queue still deep.
+            scale_up_if_needed(now);
+          }
+          catch (...)
+          {
+            // Either every task is queued or none of them
+            m_queue.resize(queue_size);
+            throw;
+          }
+          retired_workers.swap(m_retired_workers);
+        }
+        m_condition.notify_all();
+      }
+
+      elastic_pool_metrics_t metrics() const
+      {
+        std::lock_guard lock(m_mutex);
+        elastic_pool_metrics_t result = m_metrics;
+        result.thread_count = m_workers.size();
+        result.idle_count = m_idle_count;
+        result.queue_depth = m_queue.size();
+        return result;
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             elastic_thread_pool_t* pool,
+                             std::function<void()> callback)
+      {
+        pool->push(std::move(callback));
+      }
+      friend void tag_invoke(schedule_bulk_t,
+                             elastic_thread_pool_t* pool,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t&)
+      {
+        pool->push_bulk(std::move(callbacks));
+      }
+      friend bool tag_invoke(run_pending_task_t,
+                             elastic_thread_pool_t* pool,
+                             std::stop_token ready)
+      {
+        return pool->run_pending(std::move(ready));
+      }
+
+    private:
+      // The calling worker executes a task instead of blocking
+      bool run_pending(std::stop_token ready)
+      {
+        if (__details::current_worker_owner() != this)
+        {
+          return false;
+        }
+        std::unique_lock lock(m_mutex);
+        const bool has_task = m_condition.wait(
+            lock,
+            ready,
+            [&] { return m_stop_requested || m_queue.empty() == false; });
+        if (m_stop_requested)
+        {
+          return false;
+        }
+        if (has_task)
+        {
+          execute_next(lock);
+        }
+        return true;
+      }
+
+      using worker_clock_t = std::chrono::steady_clock;
+      using worker_iterator_t = std::list<std::jthread>::iterator;
+
+      struct entry_t
+      {
+          std::function<void()> callback;
+          worker_clock_t::time_point enqueued_at;
+      };
+      // Shared with the timer, the pool is detached when it's destroyed
+      struct latency_check_t
+      {
+          explicit latency_check_t(elastic_thread_pool_t* pool)
+              : pool(pool)
+          {
+          }
+          std::mutex mutex;
+          elastic_thread_pool_t* pool;
+      };
+
+      // Must be called under the lock
+      void scale_up_if_needed(worker_clock_t::time_point now)
+      {
+        if (m_stop_requested || m_workers.size() >= m_options.max_threads ||
+            m_queue.empty())
+        {
+          return;
+        }
+        const std::size_t backlog =
+            m_queue.size() > m_idle_count ? m_queue.size() - m_idle_count : 0;
+        const bool too_deep = backlog >= m_options.spawn_queue_depth;
+        const bool too_late =
+            backlog > 0 &&
+            now - m_queue.front().enqueued_at >= m_options.spawn_latency;
+        if (m_workers.empty() || too_deep || too_late)
+        {
+          try
+          {
+            spawn_worker();
+          }
+          catch (...)
+          {
+            // The queued tasks are executed by the existing workers
+            if (m_workers.empty())
+            {
+              throw;
+            }
+          }
+        }
+        else if (backlog > 0 && m_latency_check_armed == false)
+        {
+          arm_latency_check(m_queue.front().enqueued_at +
+                            m_options.spawn_latency);
+        }
+      }
+
+      /**
+       * The busy workers can't notice that the oldest task waits too long,
+       * the timer thread checks it when it's due. Must be called under the
+       * lock.
+       */
+      void arm_latency_check(worker_clock_t::time_point expiry)
+      {
+        m_latency_check_timer =
+            __details::timer_service_t::instance().schedule_at(
+                expiry,
+                [p_check = m_latency_check] { check_latency(*p_check); });
+        m_latency_check_armed = true;
+      }
+      // Called on the timer thread
+      static void check_latency(latency_check_t& check)
+      {
+        std::lock_guard check_lock(check.mutex);
+        if (check.pool == nullptr)
+        {
+          return;
+        }
+        elastic_thread_pool_t& pool = *check.pool;
+        std::lock_guard lock(pool.m_mutex);
+        pool.m_latency_check_armed = false;
+        try
+        {
+          pool.scale_up_if_needed(worker_clock_t::now());
+        }
+        catch (...)
+        {
+          // Nothing to do without workers, the next push tries again
+        }
+      }
+
+      // Must be called under the lock
+      void spawn_worker()
+      {
+        CF_PROFILE_SCOPE();
+        // The worker can't start its loop until the lock is released, thus
+        // the iterator is valid by the time it uses it.
+        worker_iterator_t self = m_workers.emplace(m_workers.end());
+        try
+        {
+          *self = std::jthread([this, self] { worker_loop(self); });
+        }
+        catch (...)
+        {
+          m_workers.erase(self);
+          throw;
+        }
+        ++m_metrics.spawned;
+        m_metrics.peak_thread_count =
+            std::max(m_metrics.peak_thread_count, m_workers.size());
+      }
+
+      void worker_loop(worker_iterator_t self)
+      {
+        __details::current_worker_owner() = this;
+        std::unique_lock lock(m_mutex);
+        while (true)
+        {
+          ++m_idle_count;
+          const bool has_task = m_condition.wait_for(
+              lock,
+              m_options.idle_timeout,
+              [&] { return m_stop_requested || m_queue.empty() == false; });
+          --m_idle_count;
+          // The queue is drained before the worker stops
+          if (m_stop_requested && m_queue.empty())
+          {
+            return;
+          }
+          if (has_task == false)
+          {
+            if (m_workers.size() > m_options.min_threads)
+            {
+              // The thread object is joined by the next push or at the
+              // destruction of the pool.
+              m_retired_workers.splice(
+                  m_retired_workers.end(), m_workers, self);
+              ++m_metrics.retired;
+              return;
+            }
+            continue;
+          }
+          execute_next(lock);
+        }
+      }
+
+      // The lock is released during the execution
+      void execute_next(std::unique_lock<std::mutex>& lock)
+      {
+        std::function<void()> callback = std::move(m_queue.front().callback);
+        m_queue.pop_front();
+        // Busy workers can't notice the waiting tasks, check it here too.
+        scale_up_if_needed(worker_clock_t::now());
+        lock.unlock();
+        {
+          CF_PROFILE_SCOPE_N("elastic_thread_pool_t::execute");
+          callback();
+        }
+        callback = nullptr;
+        lock.lock();
+      }
+
+      elastic_pool_options_t m_options;
+      std::deque<entry_t> m_queue;
+      std::size_t m_idle_count{ 0 };
+      bool m_stop_requested{ false };
+      elastic_pool_metrics_t m_metrics;
+      std::shared_ptr<latency_check_t> m_latency_check;
+      bool m_latency_check_armed{ false };
+      __details::timer_id_t m_latency_check_timer;
+      mutable std::mutex m_mutex;
+      std::condition_variable_any m_condition;
+      std::list<std::jthread> m_workers;
+      std::list<std::jthread> m_retired_workers;
+  };
+} // namespace schedulers
+} // namespace coroutine_flow
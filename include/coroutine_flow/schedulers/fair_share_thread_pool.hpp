@@ -0,0 +1,263 @@
+#pragma once
+
+#include <coroutine_flow/__details/worker_pool.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <unordered_map>
+#include <vector>
+
+namespace coroutine_flow
+{
+struct group_statistics_t
+{
+    std::size_t queue_depth{ 0 };
+    std::uint64_t executed{ 0 };
+    // Wall-clock time the workers spent executing the tasks of the group,
+    // including the time they were blocked or preempted.
+    std::chrono::nanoseconds busy_time{ 0 };
+};
+
+namespace __details
+{
+  /**
+   * Deficit round robin over the groups of the tasks. The cost of a task is
+   * not known before its execution, thus the average cost of its group (a
+   * quantum until it's measured) is charged when it's dequeued. The
+   * difference to the measured execution time is reconciled afterwards.
+   * Thus, the concurrent workers can't dequeue a burst of tasks from a group
+   * before any of them is charged. A group with more weight receives
+   * proportionally bigger quantum in every round.
+   *
+   * Groups are never removed, their state is referenced by the running tasks.
+   */
+  class fair_share_queue_t
+  {
+    public:
+      explicit fair_share_queue_t(std::chrono::nanoseconds quantum)
+          : m_quantum(quantum)
+      {
+      }
+
+      void set_weight(group_id_t group, std::uint32_t weight)
+      {
+        get_group(group).weight = weight == 0 ? 1 : weight;
+      }
+
+      void push(std::function<void()> callback,
+                const schedule_hints_t& hints,
+                worker_clock_t::time_point)
+      {
+        group_t& group = get_group(hints.group);
+        group.tasks.push_back(std::move(callback));
+        try
+        {
+          activate(group);
+        }
+        catch (...)
+        {
+          group.tasks.pop_back();
+          throw;
+        }
+        ++m_size;
+      }
+      void push_bulk(std::vector<std::function<void()>>& callbacks,
+                     const schedule_hints_t& hints,
+                     worker_clock_t::time_point)
+      {
+        group_t& group = get_group(hints.group);
+        const std::size_t group_size = group.tasks.size();
+        try
+        {
+          for (auto& callback : callbacks)
+          {
+            group.tasks.push_back(std::move(callback));
+          }
+          activate(group);
+        }
+        catch (...)
+        {
+          group.tasks.resize(group_size);
+          throw;
+        }
+        m_size += callbacks.size();
+      }
+
+      std::optional<std::function<void()>> pop(worker_clock_t::time_point)
+      {
+        while (m_active_groups.empty() == false)
+        {
+          group_t& group = *m_active_groups.front();
+          group.deficit -=
+              group.pending_charge.exchange(0, std::memory_order_relaxed);
+          if (group.deficit <= 0)
+          {
+            group.deficit += quantum_of(group);
+            m_active_groups.pop_front();
+            m_active_groups.push_back(&group);
+            continue;
+          }
+          const std::int64_t estimated_cost = estimated_cost_of(group);
+          auto callback = std::move(group.tasks.front());
+          group.tasks.pop_front();
+          group.deficit -= estimated_cost;
+          --m_size;
+          if (group.tasks.empty())
+          {
+            group.active = false;
+            m_active_groups.pop_front();
+          }
+          return [p_group = &group,
+                  p_estimated_cost = estimated_cost,
+                  p_callback = std::move(callback)]
+          {
+            const auto start = worker_clock_t::now();
+            p_callback();
+            const std::int64_t elapsed =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    worker_clock_t::now() - start)
+                    .count();
+            // Negative when the task was cheaper than the estimate
+            p_group->pending_charge.fetch_add(elapsed - p_estimated_cost,
+                                              std::memory_order_relaxed);
+            p_group->busy_time.fetch_add(elapsed, std::memory_order_relaxed);
+            p_group->executed.fetch_add(1, std::memory_order_relaxed);
+          };
+        }
+        return std::nullopt;
+      }
+
+      bool empty() const { return m_size == 0; }
+      std::size_t size() const { return m_size; }
+
+      group_statistics_t statistics(group_id_t group_id) const
+      {
+        auto it = m_groups.find(group_id);
+        if (it == m_groups.end())
+        {
+          return {};
+        }
+        const group_t& group = it->second;
+        return { .queue_depth = group.tasks.size(),
+                 .executed = group.executed.load(std::memory_order_relaxed),
+                 .busy_time = std::chrono::nanoseconds{
+                     group.busy_time.load(std::memory_order_relaxed) } };
+      }
+
+    private:
+      struct group_t
+      {
+          std::deque<std::function<void()>> tasks;
+          std::uint32_t weight{ 1 };
+          std::int64_t deficit{ 0 };
+          bool active{ false };
+          // Written by the workers outside of the queue lock
+          std::atomic_int64_t pending_charge{ 0 };
+          std::atomic_int64_t busy_time{ 0 };
+          std::atomic_uint64_t executed{ 0 };
+      };
+
+      group_t& get_group(group_id_t group)
+      {
+        return m_groups.try_emplace(group).first->second;
+      }
+      // The group is changed only when it's linked in
+      void activate(group_t& group)
+      {
+        if (group.active == false)
+        {
+          m_active_groups.push_back(&group);
+          group.active = true;
+          group.deficit = quantum_of(group);
+        }
+      }
+      std::int64_t quantum_of(const group_t& group) const
+      {
+        return m_quantum.count() * group.weight;
+      }
+      // Average execution time of the group, a quantum until it's measured
+      std::int64_t estimated_cost_of(const group_t& group) const
+      {
+        const std::uint64_t executed =
+            group.executed.load(std::memory_order_relaxed);
+        if (executed == 0)
+        {
+          return m_quantum.count();
+        }
+        return group.busy_time.load(std::memory_order_relaxed) /
+               static_cast<std::int64_t>(executed);
+      }
+
+      std::unordered_map<group_id_t, group_t> m_groups;
+      std::deque<group_t*> m_active_groups;
+      std::size_t m_size{ 0 };
+      std::chrono::nanoseconds m_quantum;
+  };
+} // namespace __details
+
+namespace schedulers
+{
+  /**
+   * Thread pool that shares the workers between the groups of the tasks
+   * (schedule_hints_t::group) according to their weight. A group that floods
+   * the pool can use only its share of the execution time while the other
+   * groups have pending tasks.
+   */
+  class fair_share_thread_pool_t
+  {
+    public:
+      static constexpr const auto c_default_quantum =
+          std::chrono::microseconds{ 500 };
+
+      explicit fair_share_thread_pool_t(
+          std::size_t thread_count,
+          std::chrono::nanoseconds quantum = c_default_quantum)
+          : m_pool(thread_count, quantum)
+      {
+      }
+
+      void set_weight(group_id_t group, std::uint32_t weight)
+      {
+        m_pool.with_queue([&](__details::fair_share_queue_t& queue)
+                          { queue.set_weight(group, weight); });
+      }
+
+      group_statistics_t statistics(group_id_t group) const
+      {
+        return m_pool.with_queue(
+            [&](const __details::fair_share_queue_t& queue)
+            { return queue.statistics(group); });
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             fair_share_thread_pool_t* pool,
+                             std::function<void()> callback,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push(std::move(callback), hints);
+      }
+      friend void tag_invoke(schedule_bulk_t,
+                             fair_share_thread_pool_t* pool,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push_bulk(std::move(callbacks), hints);
+      }
+      friend bool tag_invoke(run_pending_task_t,
+                             fair_share_thread_pool_t* pool,
+                             std::stop_token ready)
+      {
+        return pool->m_pool.run_pending(std::move(ready));
+      }
+
+    private:
+      __details::worker_pool_t<__details::fair_share_queue_t> m_pool;
+  };
+} // namespace schedulers
+} // namespace coroutine_flow
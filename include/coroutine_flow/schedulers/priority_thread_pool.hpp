@@ -0,0 +1,177 @@
+#pragma once
+
+#include <coroutine_flow/__details/worker_pool.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  /**
+   * Multi-level FIFO queue. Every level is served in FIFO order, the level is
+   * selected by the effective priority of its oldest entry.
+   *
+   * Aging: an entry that waits for `aging_step` is treated as if it was one
+   * level higher. Thus a low priority entry overtakes the fresh critical ones
+   * after (c_priority_levels - 1) * aging_step and can't starve.
+   */
+  class priority_queue_t
+  {
+    public:
+      explicit priority_queue_t(std::chrono::nanoseconds aging_step)
+          : m_aging_step(aging_step)
+      {
+      }
+
+      void push(std::function<void()> callback,
+                const schedule_hints_t& hints,
+                worker_clock_t::time_point now)
+      {
+        m_levels[static_cast<std::size_t>(hints.priority)].push_back(
+            { std::move(callback), now });
+        ++m_size;
+      }
+      void push_bulk(std::vector<std::function<void()>>& callbacks,
+                     const schedule_hints_t& hints,
+                     worker_clock_t::time_point now)
+      {
+        auto& entries = m_levels[static_cast<std::size_t>(hints.priority)];
+        const std::size_t level_size = entries.size();
+        try
+        {
+          for (auto& callback : callbacks)
+          {
+            entries.push_back({ std::move(callback), now });
+          }
+        }
+        catch (...)
+        {
+          entries.resize(level_size);
+          throw;
+        }
+        m_size += callbacks.size();
+      }
+
+      std::optional<std::function<void()>> pop(worker_clock_t::time_point now)
+      {
+        std::deque<entry_t>* selected = nullptr;
+        std::int64_t selected_priority = 0;
+        for (std::size_t level = 0; level < m_levels.size(); ++level)
+        {
+          auto& entries = m_levels[level];
+          if (entries.empty())
+          {
+            continue;
+          }
+          const std::int64_t priority =
+              static_cast<std::int64_t>(level) +
+              age_of(entries.front().enqueued_at, now);
+          // On equal priority the older one wins.
+          if (selected == nullptr || priority > selected_priority ||
+              (priority == selected_priority &&
+               entries.front().enqueued_at < selected->front().enqueued_at))
+          {
+            selected = &entries;
+            selected_priority = priority;
+          }
+        }
+        if (selected == nullptr)
+        {
+          return std::nullopt;
+        }
+        auto result = std::move(selected->front().callback);
+        selected->pop_front();
+        --m_size;
+        return result;
+      }
+
+      bool empty() const { return m_size == 0; }
+      std::size_t size() const { return m_size; }
+      std::size_t size(priority_t priority) const
+      {
+        return m_levels[static_cast<std::size_t>(priority)].size();
+      }
+
+    private:
+      struct entry_t
+      {
+          std::function<void()> callback;
+          worker_clock_t::time_point enqueued_at;
+      };
+
+      std::int64_t age_of(worker_clock_t::time_point enqueued_at,
+                          worker_clock_t::time_point now) const
+      {
+        if (m_aging_step.count() <= 0)
+        {
+          return 0;
+        }
+        return (now - enqueued_at) / m_aging_step;
+      }
+
+      std::array<std::deque<entry_t>, c_priority_levels> m_levels;
+      std::size_t m_size{ 0 };
+      std::chrono::nanoseconds m_aging_step;
+  };
+} // namespace __details
+
+namespace schedulers
+{
+  /**
+   * Thread pool that executes the tasks according to the priority in their
+   * schedule_hints_t. The priority is set at run_async/sync_wait and inherited
+   * by every co_awaited coroutine.
+   */
+  class priority_thread_pool_t
+  {
+    public:
+      static constexpr const auto c_default_aging_step =
+          std::chrono::milliseconds{ 10 };
+
+      explicit priority_thread_pool_t(
+          std::size_t thread_count,
+          std::chrono::nanoseconds aging_step = c_default_aging_step)
+          : m_pool(thread_count, aging_step)
+      {
+      }
+
+      std::size_t queue_size(priority_t priority) const
+      {
+        return m_pool.with_queue([&](const __details::priority_queue_t& queue)
+                                 { return queue.size(priority); });
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             priority_thread_pool_t* pool,
+                             std::function<void()> callback,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push(std::move(callback), hints);
+      }
+      friend void tag_invoke(schedule_bulk_t,
+                             priority_thread_pool_t* pool,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t& hints)
+      {
+        pool->m_pool.push_bulk(std::move(callbacks), hints);
+      }
+      friend bool tag_invoke(run_pending_task_t,
+                             priority_thread_pool_t* pool,
+                             std::stop_token ready)
+      {
+        return pool->m_pool.run_pending(std::move(ready));
+      }
+
+    private:
+      __details::worker_pool_t<__details::priority_queue_t> m_pool;
+  };
+} // namespace schedulers
+} // namespace coroutine_flow
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <coroutine_flow/__details/submit_buffer.hpp>
+#include <coroutine_flow/__details/timer_wheel.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace schedulers
+{
+  /**
+   * Scheduler without own threads: the tasks are executed by the threads
+   * that drive the loop (run/run_one or sync_wait). It is useful to execute
+   * coroutines on the main thread or to wait for a result without wasting a
+   * core on blocking.
+   *
+   * Tasks that are still in the queue when the loop is destroyed might
+   * continue suspended coroutines, the destructor executes them (and the
+   * tasks they queue). Tasks that wait for their timer are dropped.
+   */
+  class run_loop_t
+  {
+    public:
+      run_loop_t() = default;
+      run_loop_t(const run_loop_t&) = delete;
+      run_loop_t(run_loop_t&&) = delete;
+
+      run_loop_t& operator=(const run_loop_t&) = delete;
+      run_loop_t& operator=(run_loop_t&&) = delete;
+
+      ~run_loop_t()
+      {
+        std::unique_lock lock(m_mutex);
+        while (m_queue.empty() == false)
+        {
+          execute_next(lock);
+        }
+      }
+
+      void push(std::function<void()> callback)
+      {
+        {
+          std::lock_guard lock(m_mutex);
+          m_queue.push_back(std::move(callback));
+        }
+        m_condition.notify_one();
+      }
+
+      void push_bulk(std::vector<std::function<void()>> callbacks)
+      {
+        {
+          std::lock_guard lock(m_mutex);
+          // Inserting at the end has no effect when it throws
+          m_queue.insert(m_queue.end(),
+                         std::make_move_iterator(callbacks.begin()),
+                         std::make_move_iterator(callbacks.end()));
+        }
+        m_condition.notify_all();
+      }
+
+      /**
+       * The task is queued when the time point is reached. The loop waits for
+       * its timers itself, no timer thread is involved.
+       */
+      void push_at(std::function<void()> callback,
+                   timer_clock_t::time_point expiry)
+      {
+        {
+          std::lock_guard lock(m_mutex);
+          m_timers.schedule_at(expiry, std::move(callback));
+        }
+        // The driving threads sleep until the earliest expiry
+        m_condition.notify_all();
+      }
+
+      /**
+       * Executes the tasks until finish is called and the queue is drained.
+       * Pending timers don't keep it running.
+       */
+      void run()
+      {
+        CF_PROFILE_SCOPE();
+        // Driven from a coroutine its buffered tasks might target this loop
+        __details::submit_buffer_t::instance().flush();
+        std::unique_lock lock(m_mutex);
+        while (wait_for_task(lock, timer_clock_t::time_point::max(), true))
+        {
+          execute_next(lock);
+        }
+      }
+      /**
+       * Executes one task, it waits at most max_wait for it. Returns false
+       * when there was nothing to execute.
+       */
+      bool run_one(std::chrono::nanoseconds max_wait)
+      {
+        __details::submit_buffer_t::instance().flush();
+        std::unique_lock lock(m_mutex);
+        if (wait_for_task(
+                lock,
+                timer_clock_t::now() +
+                    std::chrono::ceil<timer_clock_t::duration>(max_wait),
+                false) == false)
+        {
+          return false;
+        }
+        execute_next(lock);
+        return true;
+      }
+      // Lets run return when the queue is drained
+      void finish()
+      {
+        {
+          std::lock_guard lock(m_mutex);
+          m_finishing = true;
+        }
+        m_condition.notify_all();
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             run_loop_t* loop,
+                             std::function<void()> callback)
+      {
+        loop->push(std::move(callback));
+      }
+      friend void tag_invoke(schedule_bulk_t,
+                             run_loop_t* loop,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t&)
+      {
+        loop->push_bulk(std::move(callbacks));
+      }
+      friend void tag_invoke(schedule_at_t,
+                             run_loop_t* loop,
+                             std::function<void()> callback,
+                             timer_clock_t::time_point expiry,
+                             const schedule_hints_t&)
+      {
+        loop->push_at(std::move(callback), expiry);
+      }
+      // Any thread can drive the loop.
+      friend bool tag_invoke(run_pending_task_t,
+                             run_loop_t* loop,
+                             std::stop_token ready)
+      {
+        loop->run_pending(std::move(ready));
+        return true;
+      }
+
+    private:
+      // Executes one task unless stop is requested on ready before it comes
+      void run_pending(std::stop_token ready)
+      {
+        __details::submit_buffer_t::instance().flush();
+        // Registered before the lock is taken: it might be called in place
+        std::stop_callback wake_up(ready,
+                                   [this]
+                                   {
+                                     std::lock_guard lock(m_mutex);
+                                     m_condition.notify_all();
+                                   });
+        std::unique_lock lock(m_mutex);
+        if (wait_for_task(lock, timer_clock_t::time_point::max(), false, ready))
+        {
+          execute_next(lock);
+        }
+      }
+
+      void queue_expired_timers()
+      {
+        m_timers.advance(timer_clock_t::now(), m_expired);
+        for (auto& callback : m_expired)
+        {
+          m_queue.push_back(std::move(callback));
+        }
+        m_expired.clear();
+      }
+      /**
+       * Waits until a task is queued or the time point is reached, the
+       * expired timers are queued meanwhile. Returns false when there is
+       * nothing to execute (timeout, stop request, or finish when
+       * stop_on_finish is set).
+       */
+      bool wait_for_task(std::unique_lock<std::mutex>& lock,
+                         timer_clock_t::time_point until,
+                         bool stop_on_finish,
+                         const std::stop_token& stop_token = {})
+      {
+        while (true)
+        {
+          queue_expired_timers();
+          if (m_queue.empty() == false)
+          {
+            return true;
+          }
+          const auto now = timer_clock_t::now();
+          if ((stop_on_finish && m_finishing) || now >= until ||
+              stop_token.stop_requested())
+          {
+            return false;
+          }
+          const auto wake_up =
+              std::min(until, m_timers.next_wake_up().value_or(until));
+          if (wake_up == timer_clock_t::time_point::max())
+          {
+            m_condition.wait(lock);
+          }
+          else
+          {
+            m_condition.wait_until(lock, wake_up);
+          }
+        }
+      }
+
+      // The lock is released during the execution
+      void execute_next(std::unique_lock<std::mutex>& lock)
+      {
+        std::function<void()> callback = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        {
+          CF_PROFILE_SCOPE_N("run_loop_t::execute");
+          callback();
+        }
+        callback = nullptr;
+        lock.lock();
+      }
+
+      std::deque<std::function<void()>> m_queue;
+      __details::timer_wheel_t m_timers;
+      std::vector<std::function<void()>> m_expired;
+      bool m_finishing{ false };
+      std::mutex m_mutex;
+      std::condition_variable m_condition;
+  };
+} // namespace schedulers
+
+using run_loop = schedulers::run_loop_t;
+
+/**
+ * The calling thread executes the coroutine: it drives a run loop until the
+ * coroutine is finished.
+ */
+template <typename T>
+T sync_wait(task<T>&& task, schedule_hints_t hints = {})
+{
+  schedulers::run_loop_t loop;
+  return sync_wait(std::move(task), &loop, hints);
+}
+} // namespace coroutine_flow
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  /**
+   * The computation and its result. The computation is started by the first
+   * awaiter, the awaiters that come before it's finished are parked in the
+   * waiter list and resumed together.
+   */
+  template <typename T>
+  class shared_task_state_t
+  {
+    public:
+      explicit shared_task_state_t(task<T>&& computation)
+          : m_computation(std::move(computation))
+      {
+      }
+
+      bool is_ready() const { return m_ready.load(std::memory_order_acquire); }
+      /**
+       * Returns false when the result is already available, then the awaiter
+       * continues immediately.
+       */
+      bool add_waiter(std::shared_ptr<shared_task_state_t> self,
+                      suspended_task_t waiter)
+      {
+        std::optional<task<T>> computation;
+        task_context_t context = waiter.context();
+        {
+          std::lock_guard lock(m_mutex);
+          if (is_ready())
+          {
+            return false;
+          }
+          m_waiters.push_back(std::move(waiter));
+          if (m_computation.has_value())
+          {
+            computation.emplace(std::move(*m_computation));
+            m_computation.reset();
+          }
+        }
+        if (computation.has_value())
+        {
+          // Shared by every awaiter, stopping one of them mustn't stop it
+          context.stop_token = std::stop_token{};
+          start_detached(run(std::move(*computation), std::move(self)),
+                         context);
+        }
+        return true;
+      }
+      const T& result() const
+      {
+        if (m_exception)
+        {
+          std::rethrow_exception(m_exception);
+        }
+        return *m_result;
+      }
+
+    private:
+      static task<int> run(task<T> computation,
+                           std::shared_ptr<shared_task_state_t> self)
+      {
+        try
+        {
+          self->m_result.emplace(co_await std::move(computation));
+        }
+        catch (...)
+        {
+          self->m_exception = std::current_exception();
+        }
+        self->on_finished();
+        co_return 0;
+      }
+      void on_finished()
+      {
+        std::vector<suspended_task_t> waiters;
+        {
+          std::lock_guard lock(m_mutex);
+          m_ready.store(true, std::memory_order_release);
+          waiters.swap(m_waiters);
+        }
+        for (suspended_task_t& waiter : waiters)
+        {
+          waiter.resume();
+        }
+      }
+
+      std::mutex m_mutex;
+      std::optional<task<T>> m_computation;
+      std::vector<suspended_task_t> m_waiters;
+      std::atomic_bool m_ready{ false };
+      std::optional<T> m_result;
+      std::exception_ptr m_exception;
+  };
+} // namespace __details
+
+/**
+ * A task that can be co_awaited by many coroutines, e.g. a lazily loaded
+ * configuration. The computation is started once, by the first awaiter, on
+ * its scheduler. Every awaiter gets a const reference to the same result
+ * (or the same exception is rethrown), the ones that come after the
+ * computation is finished continue without suspending. Copies refer to the
+ * same computation, the result lives until the last copy is destroyed.
+ *
+ * cf::shared_task<config_t> config(load_config());
+ * const config_t& value = co_await config;
+ */
+template <typename T>
+class shared_task
+{
+  public:
+    explicit shared_task(task<T>&& computation)
+        : m_state(std::make_shared<__details::shared_task_state_t<T>>(
+              std::move(computation)))
+    {
+    }
+
+    bool is_ready() const { return m_state->is_ready(); }
+    // Whether they refer to the same computation
+    bool operator==(const shared_task&) const = default;
+
+    bool await_ready() const { return m_state->is_ready(); }
+    bool await_suspend(__details::suspended_task_t suspended_task)
+    {
+      CF_PROFILE_SCOPE();
+      return m_state->add_waiter(m_state, std::move(suspended_task));
+    }
+    const T& await_resume() const { return m_state->result(); }
+
+  private:
+    std::shared_ptr<__details::shared_task_state_t<T>> m_state;
+};
+} // namespace coroutine_flow
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/timer_service.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <chrono>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  class sleep_awaitable_t
+  {
+    public:
+      explicit sleep_awaitable_t(timer_clock_t::time_point expiry)
+          : m_expiry(expiry)
+      {
+      }
+
+      bool await_ready() const { return m_expiry <= timer_clock_t::now(); }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        auto resumer = m_suspend.begin(std::move(suspended_task));
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        const std::optional<timer_id_t> timer = resumer->context().schedule_at(
+            [p_resumer = *resumer] { p_resumer.resume_inline(); }, m_expiry);
+        if (timer.has_value())
+        {
+          resumer->set_on_cancel(
+              [p_timer = *timer]
+              { timer_service_t::instance().cancel(p_timer); });
+        }
+        return m_suspend.end();
+      }
+      void await_resume() { m_suspend.finish(); }
+
+    private:
+      timer_clock_t::time_point m_expiry;
+      cancellable_suspend_t m_suspend;
+  };
+} // namespace __details
+
+/**
+ * Suspends the coroutine without blocking its worker, it's continued on its
+ * scheduler when the time point is reached. Schedulers with native timers
+ * (schedule_at_t/schedule_after_t) get the timer itself, the others get the
+ * continuation from the timer thread of the library. When stop is requested
+ * for the coroutine the sleep is interrupted with operation_cancelled_error.
+ *
+ * co_await cf::sleep_for(std::chrono::milliseconds(100));
+ */
+inline __details::sleep_awaitable_t
+    sleep_until(timer_clock_t::time_point expiry)
+{
+  return __details::sleep_awaitable_t(expiry);
+}
+template <typename rep_t, typename period_t>
+__details::sleep_awaitable_t
+    sleep_for(std::chrono::duration<rep_t, period_t> duration)
+{
+  return sleep_until(
+      timer_clock_t::now() +
+      std::chrono::ceil<timer_clock_t::duration>(duration));
+}
+} // namespace coroutine_flow
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <coroutine_flow/__details/mpsc_queue.hpp>
+#include <coroutine_flow/__details/scope_exit.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace schedulers
+{
+  template <task_scheduler scheduler_t>
+  class strand_t;
+}
+namespace __details
+{
+  // Strand work executed by one drain before the strand yields its worker
+  constexpr const std::size_t c_strand_batch_size = 64;
+
+  template <task_scheduler scheduler_t>
+  class strand_state_t
+      : public std::enable_shared_from_this<strand_state_t<scheduler_t>>
+  {
+    public:
+      explicit strand_state_t(scheduler_t scheduler)
+          : m_scheduler(std::move(scheduler))
+      {
+      }
+
+      void push(std::function<void()> callback, const schedule_hints_t& hints)
+      {
+        m_queue.push(std::move(callback));
+        // Only the one who makes the strand non-empty schedules the drain,
+        // the others are executed by that drain.
+        if (m_pending_count.fetch_add(1, std::memory_order_acq_rel) == 0)
+        {
+          schedule_drain(hints);
+        }
+      }
+
+      void push_bulk(std::vector<std::function<void()>> callbacks,
+                     const schedule_hints_t& hints)
+      {
+        if (callbacks.empty())
+        {
+          return;
+        }
+        m_queue.push_bulk(callbacks);
+        if (m_pending_count.fetch_add(callbacks.size(),
+                                      std::memory_order_acq_rel) == 0)
+        {
+          schedule_drain(hints);
+        }
+      }
+
+    private:
+      void schedule_drain(const schedule_hints_t& hints)
+      {
+        schedule_task(
+            m_scheduler,
+            [p_self = this->shared_from_this(), hints]
+            { p_self->drain(hints); },
+            hints);
+      }
+
+      void drain(const schedule_hints_t& hints)
+      {
+        CF_PROFILE_SCOPE();
+        std::size_t executed = 0;
+        // Runs when a callback throws too: the rest of the strand is drained
+        // by the next batch and the exception goes to the scheduler.
+        scope_exit_t finish_batch([&]() noexcept { finish(executed, hints); });
+        std::size_t available = m_pending_count.load(std::memory_order_acquire);
+        while (true)
+        {
+          while (executed < available && executed < c_strand_batch_size)
+          {
+            std::function<void()> callback = m_queue.pop_pushed();
+            ++executed;
+            CF_PROFILE_SCOPE_N("strand_t::execute");
+            callback();
+          }
+          if (executed == c_strand_batch_size)
+          {
+            break;
+          }
+          // The work that arrived meanwhile is drained by this batch too.
+          available = m_pending_count.load(std::memory_order_acquire);
+          if (executed == available)
+          {
+            break;
+          }
+        }
+      }
+      // Terminates when the drain can't be rescheduled: the pending work of
+      // the strand would never be executed.
+      void finish(std::size_t executed, const schedule_hints_t& hints) noexcept
+      {
+        if (m_pending_count.fetch_sub(executed, std::memory_order_acq_rel) !=
+            executed)
+        {
+          // Either the batch is full or new work arrived after the last
+          // check. Reschedule to give the other tasks a chance to run.
+          schedule_drain(hints);
+        }
+      }
+
+      scheduler_t m_scheduler;
+      mpsc_queue_t<std::function<void()>> m_queue;
+      std::atomic<std::size_t> m_pending_count{ 0 };
+  };
+
+  template <task_scheduler scheduler_t>
+  class strand_enter_awaitable_t
+  {
+    public:
+      explicit strand_enter_awaitable_t(
+          const schedulers::strand_t<scheduler_t>& strand)
+          : m_strand(strand)
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(suspended_task_t suspended_task)
+      {
+        const schedule_hints_t hints = suspended_task.hints();
+        // The body runs until its next suspension point before the drain
+        // executes the next item of the strand.
+        schedule_task(
+            m_strand,
+            [p_suspended_task = std::move(suspended_task)]() mutable
+            { p_suspended_task.resume_inline(); },
+            hints);
+      }
+      void await_resume() const noexcept {}
+
+    private:
+      schedulers::strand_t<scheduler_t> m_strand;
+  };
+} // namespace __details
+
+namespace schedulers
+{
+  /**
+   * Serializes the tasks that are submitted through it: they are executed on
+   * the wrapped scheduler, but never concurrently and in the order of their
+   * submission. It can replace a mutex that protects some shared state
+   * without blocking the workers.
+   *
+   * The submitted tasks are collected in a lock-free queue and executed in
+   * batches by one scheduled drain, thus the wrapped scheduler is not called
+   * for every task. Copies of the strand share the same queue.
+   */
+  template <task_scheduler scheduler_t>
+  class strand_t
+  {
+    public:
+      explicit strand_t(scheduler_t scheduler)
+          : m_state(std::make_shared<__details::strand_state_t<scheduler_t>>(
+                std::move(scheduler)))
+      {
+      }
+
+      /**
+       * Continues the coroutine on the strand. It runs there until its next
+       * suspension point (e.g. co_await of another task).
+       *
+       * co_await strand.enter();
+       */
+      __details::strand_enter_awaitable_t<scheduler_t> enter() const
+      {
+        return __details::strand_enter_awaitable_t<scheduler_t>(*this);
+      }
+
+      friend void tag_invoke(schedule_task_t,
+                             const strand_t& strand,
+                             std::function<void()> callback,
+                             const schedule_hints_t& hints)
+      {
+        strand.m_state->push(std::move(callback), hints);
+      }
+
+      friend void tag_invoke(schedule_bulk_t,
+                             const strand_t& strand,
+                             std::vector<std::function<void()>> callbacks,
+                             const schedule_hints_t& hints)
+      {
+        strand.m_state->push_bulk(std::move(callbacks), hints);
+      }
+
+      bool operator==(const strand_t&) const = default;
+
+    private:
+      std::shared_ptr<__details::strand_state_t<scheduler_t>> m_state;
+  };
+} // namespace schedulers
+
+template <task_scheduler scheduler_t>
+using strand = schedulers::strand_t<scheduler_t>;
+} // namespace coroutine_flow
@@ -3,8 +3,13 @@
 #include <coroutine_flow/__details/continuation_coro.hpp>
 #include <coroutine_flow/__details/continuation_data.hpp>
 #include <coroutine_flow/__details/coroutine_chain.hpp>
+#include <coroutine_flow/__details/resume_budget.hpp>
+#include <coroutine_flow/__details/resume_scope.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
 #include <coroutine_flow/__details/testing/test_injection.hpp>
 #include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
 #include <coroutine_flow/tag_invoke.hpp>
 
 #include <atomic>
@@ -14,17 +19,21 @@
 #include <expected>
 #include <functional>
 #include <future>
+#include <ranges>
+#include <stop_token>
+#include <type_traits>
+#include <vector>
 
 namespace coroutine_flow
 {
 
-struct schedule_task_t
-{
-};
 template <typename T>
 class task;
 namespace __details
 {
+  template <typename T>
+  void start_detached(task<T>&& task, const task_context_t& context);
+
   template <typename T>
   struct result_as_promise_t
   {
@@ -34,16 +43,22 @@ namespace __details
         CF_TEST_INJECTION(testing::test_injection_points_t::object__construct,
                           this);
       }
+#else
+      result_as_promise_t() = default;
+#endif
       ~result_as_promise_t()
       {
         CF_TEST_INJECTION(testing::test_injection_points_t::object__destruct,
                           this);
+        // The coroutine is destroyed without a result, the promise is broken
+        ready_source.request_stop();
       }
-#endif
       result_as_promise_t(result_as_promise_t&&) = default;
       std::unique_ptr<std::promise<T>> result_promise{
         std::make_unique<std::promise<T>>()
       };
+      // Stop is requested when the result is set, it wakes sync_wait
+      std::stop_source ready_source{ std::nostopstate };
 
       static final_coroutine_t
           execute_on(final_coroutine_t::fall_through_t _,
@@ -101,10 +116,22 @@ namespace __details
         {
           result_promise->set_exception(result.error());
         }
+        ready_source.request_stop();
       }
       void operator()() noexcept { CF_PROFILE_SCOPE(); }
   };
 
+  // Awaitable that doesn't suspend, it provides a value that is known
+  template <typename T>
+  struct ready_awaiter_t
+  {
+      T value;
+
+      bool await_ready() const noexcept { return true; }
+      void await_suspend(std::coroutine_handle<>) const noexcept {}
+      T await_resume() { return std::move(value); }
+  };
+
   template <typename T>
   struct task_promise_t
   {
@@ -112,16 +139,16 @@ namespace __details
 
       std::expected<std::optional<T>, std::exception_ptr> result;
       std::atomic_flag result_stored;
-      std::atomic_flag suspended_handle_resumed;
-      std::atomic_flag suspend_started;
 
       std::coroutine_handle<> finalizer;
 
-      std::function<void(std::function<void()>)> schedule_callback;
+      __details::task_context_t context;
       __details::coroutine_chain_t<task_promise_t> coroutine_chain;
 
       __details::result_as_promise_t<T> extension;
       bool execute_extension{ false };
+      // Set by the scheduler that sheds the start of the coroutine
+      bool shed_requested{ false };
       /**
        * When the promise is externally referenced during the final suspend
        * it won't let fall through the final_coroutine (the extension). Thus,
@@ -183,6 +210,10 @@ namespace __details
       {
         return external_referenced;
       }
+      bool destroys_itself() const noexcept
+      {
+        return execute_extension && external_referenced == false;
+      }
       void internal_release() noexcept
       {
         internal_referenced.clear(std::memory_order_release);
@@ -198,14 +229,35 @@ namespace __details
         CF_PROFILE_SCOPE();
         return task<T>{ handle_t::from_promise(*this) };
       }
-      std::suspend_always initial_suspend() noexcept
+      struct initial_awaiter_t
+      {
+          task_promise_t* promise;
+
+          bool await_ready() const noexcept { return false; }
+          void await_suspend(std::coroutine_handle<>) const noexcept {}
+          void await_resume() const
+          {
+            if (promise->shed_requested)
+            {
+              throw deadline_exceeded_error{};
+            }
+            // A cancelled tree doesn't start new work
+            if (promise->context.stop_token.stop_requested())
+            {
+              throw operation_cancelled_error{};
+            }
+          }
+      };
+      initial_awaiter_t initial_suspend() noexcept
       {
         CF_PROFILE_SCOPE();
-        return {};
+        return { this };
       }
       auto final_suspend() noexcept
       {
         CF_PROFILE_SCOPE();
+        __details::resume_scope_t::on_final_suspend(
+            handle_t::from_promise(*this));
         const bool destroy_handle = external_referenced == false;
         CF_ATTACH_NOTE("destroy handle", destroy_handle);
 
@@ -300,6 +352,12 @@ namespace __details
       }
       template <typename U>
       auto await_transform(task<U> task);
+      template <__details::library_awaitable awaitable_t>
+      auto await_transform(awaitable_t&& awaitable);
+      auto await_transform(get_stop_token_t) noexcept
+      {
+        return ready_awaiter_t<std::stop_token>{ context.stop_token };
+      }
 
       void on_result_set()
       {
@@ -308,20 +366,83 @@ namespace __details
         result_stored.notify_all();
       }
   };
+  /**
+   * Adapts a library awaitable to the coroutine chain: the handle is stored
+   * in the chain and the awaitable receives a suspended_task_t that continues
+   * the chain.
+   */
+  template <typename promise_t, library_awaitable awaitable_t>
+  struct library_awaiter_t
+  {
+      awaitable_t awaitable;
+
+      bool await_ready() { return awaitable.await_ready(); }
+      bool await_suspend(std::coroutine_handle<promise_t> suspended_handle)
+      {
+        CF_PROFILE_SCOPE();
+        promise_t& promise = suspended_handle.promise();
+        auto& chain = promise.get_coroutine_chain();
+        chain.store_suspended_handle(suspended_handle);
+
+        suspended_task_t suspended_task(
+            promise.context,
+            [p_chain = &chain] { p_chain->continue_suspended_handle(); });
+        using suspend_result_t =
+            decltype(awaitable.await_suspend(std::move(suspended_task)));
+        try
+        {
+          if constexpr (std::same_as<suspend_result_t, bool>)
+          {
+            if (awaitable.await_suspend(std::move(suspended_task)) == false)
+            {
+              chain.reset_suspended_handle();
+              return false;
+            }
+          }
+          else
+          {
+            awaitable.await_suspend(std::move(suspended_task));
+          }
+        }
+        catch (...)
+        {
+          chain.reset_suspended_handle();
+          throw;
+        }
+        // From here this awaiter might be already destroyed.
+        return true;
+      }
+      decltype(auto) await_resume() { return awaitable.await_resume(); }
+  };
+
   template <typename T>
   template <typename U>
   auto task_promise_t<T>::await_transform(task<U> task)
   {
     CF_PROFILE_SCOPE();
-    return task.run_async_impl(schedule_callback, this);
+    return task.run_async_impl(context, this);
+  }
+  template <typename T>
+  template <library_awaitable awaitable_t>
+  auto task_promise_t<T>::await_transform(awaitable_t&& awaitable)
+  {
+    CF_PROFILE_SCOPE();
+    return library_awaiter_t<task_promise_t<T>, std::decay_t<awaitable_t>>{
+      std::forward<awaitable_t>(awaitable)
+    };
   }
+  /**
+   * Awaits a task (the async call) from another coroutine. The async call is
+   * started by await_suspend after it's linked to the suspended coroutine,
+   * thus whoever finishes it continues the suspended coroutine: the first
+   * slice of the async call or a resume on any other thread.
+   */
   template <typename T, coroutine_chain_holder other_promise_type>
   struct task_awaiter_t
   {
       using promise_t = task_promise_t<T>;
       std::coroutine_handle<promise_t> current_handle;
       std::coroutine_handle<other_promise_type> suspended_handle;
-      bool has_been_suspended = true;
 
       bool await_ready()
       {
@@ -329,45 +450,20 @@ namespace __details
         CF_PROFILE_SCOPE();
         CF_TEST_INJECTION(injection_point::task__await_ready__begin,
                           suspended_handle.address());
-
-        if (current_handle.done())
-        {
-          CF_ATTACH_NOTE("async call is already finished");
-
-          const bool already_ready =
-              suspended_handle.promise().suspended_handle_resumed.test_and_set(
-                  std::memory_order_acq_rel);
-          // when we are saying: we are ready, it measn that we are not
-          // suspended
-          has_been_suspended = already_ready == false;
-          CF_ATTACH_NOTE("suspended handle is ready? ", already_ready);
-          CF_TEST_INJECTION(
-              injection_point::task__await_ready__after_test_and_set,
-              suspended_handle.address());
-
-          return already_ready;
-        }
+        // The async call is not started yet.
         return false;
       }
       T await_resume()
       {
         CF_PROFILE_SCOPE();
-        CF_ATTACH_NOTE("caused async call a suspend? ", has_been_suspended);
         CF_ATTACH_NOTE("Async task: ", current_handle.address());
 
+        // The async call is destroyed by the chain after this call.
         promise_t& promise = current_handle.promise();
         promise.result_stored.wait(false, std::memory_order_relaxed);
         std::atomic_thread_fence(std::memory_order_acquire);
 
         auto result = std::move(promise.result);
-        if (has_been_suspended == false)
-        {
-          promise.internal_release();
-          if (promise.external_referenced == false)
-          {
-            current_handle.destroy();
-          }
-        }
         if (result.has_value())
         {
           if constexpr (std::movable<T>)
@@ -384,35 +480,50 @@ namespace __details
           std::rethrow_exception(result.error());
         }
       }
-      bool await_suspend(
+      void await_suspend(
           std::coroutine_handle<other_promise_type> suspended_handle)
       {
         CF_PROFILE_SCOPE();
         using injection_point = __details::testing::test_injection_points_t;
+        assert(suspended_handle.address() == this->suspended_handle.address());
+        CF_ATTACH_NOTE("Suspended promise", suspended_handle.address());
 
-        if (current_handle.done())
+        promise_t& promise = current_handle.promise();
+        auto& current_chain = promise.get_coroutine_chain();
+        current_chain.link_to(suspended_handle);
+        // The first slice is a continue of the initially suspended async call
+        current_chain.store_suspended_handle(current_handle);
+        try
         {
-          CF_ATTACH_NOTE("Async call is finished");
-
-          const bool has_been_resumed =
-              suspended_handle.promise().suspended_handle_resumed.test_and_set(
-                  std::memory_order_acq_rel);
-          CF_ATTACH_NOTE("Has been resumed? ", has_been_resumed);
-          CF_TEST_INJECTION(
-              injection_point::task__await_suspend__after_test_and_set,
-              suspended_handle.address());
-
-          if (has_been_resumed == false)
-          {
-            return false;
-          }
+          promise.context.schedule(__details::start_callback_t{
+              [p_chain = &current_chain,
+               p_address = current_handle.address()]
+              {
+                CF_PROFILE_SCOPE_N("Task::AsyncRun");
+                CF_ATTACH_NOTE("Executed handle", p_address);
+                p_chain->continue_suspended_handle();
+                CF_TEST_INJECTION(
+                    injection_point::task__run_async__async_call_finished,
+                    p_address);
+              },
+              &promise.shed_requested });
         }
-        assert(suspended_handle.address() == this->suspended_handle.address());
-
-        other_promise_type& promise = suspended_handle.promise();
-        CF_ATTACH_NOTE("Suspended promise", suspended_handle.address());
-        promise.get_coroutine_chain().store_suspended_handle(suspended_handle);
-        return true;
+        catch (...)
+        {
+          // Nobody references the async call, the exception is thrown by the
+          // co_await.
+          current_chain.reset_suspended_handle();
+          current_chain.unlink();
+          current_handle.destroy();
+          throw;
+        }
+        /*
+        From here this awaiter might be already destroyed: the async call might
+        be finished and the suspended coroutine continued on another thread.
+        */
+        CF_TEST_INJECTION(
+            injection_point::task__await_suspend__async_call_scheduled,
+            suspended_handle.address());
       }
   };
 
@@ -444,6 +555,19 @@ class task
                         coro_handle.address());
       CF_TEST_INJECTION(injection_point::object__construct, this);
     }
+    // Moving makes possible to store not yet started tasks in containers
+    task(task&& other) noexcept
+        : m_coro_handle(std::exchange(other.m_coro_handle, {}))
+        , m_result_future(std::move(other.m_result_future))
+    {
+      CF_TEST_INJECTION(
+          __details::testing::test_injection_points_t::object__construct,
+          this);
+    }
+    task(const task&) = delete;
+
+    task& operator=(const task&) = delete;
+    task& operator=(task&&) = delete;
 
     void* address() { return m_coro_handle.address(); }
 
@@ -458,190 +582,292 @@ class task
           this);
     }
 
-    template <typename U, typename scheduler_t>
-      requires(
-          std::copyable<scheduler_t> &&
-          is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>>)
-    friend void run_async(task<U>&& task, scheduler_t scheduler);
+    template <typename U, task_scheduler scheduler_t>
+    friend void run_async(task<U>&& task,
+                          scheduler_t scheduler,
+                          schedule_hints_t hints,
+                          std::stop_token stop_token);
 
-    template <typename U, typename scheduler_t>
-      requires(
-          std::copyable<scheduler_t> &&
-          is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>>)
-    friend U sync_wait(task<U>&& task, scheduler_t scheduler);
+    template <typename U, task_scheduler scheduler_t>
+    friend U sync_wait(task<U>&& task,
+                       scheduler_t scheduler,
+                       schedule_hints_t hints);
+
+    template <typename range_t, task_scheduler scheduler_t>
+    friend void run_async_bulk(range_t&& tasks,
+                               scheduler_t scheduler,
+                               schedule_hints_t hints);
+
+    template <typename U>
+    friend void __details::start_detached(
+        task<U>&& task,
+        const __details::task_context_t& context);
 
   private:
-    template <typename scheduler_t>
-      requires(
-          std::copyable<scheduler_t> &&
-          is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>>)
-    handle_t schedule(scheduler_t scheduler, bool keep_handle_alive)
+    /**
+     * Starts the coroutine as a top level coroutine. It destroys itself when
+     * it's finished, its result is available via m_result_future.
+     */
+    template <task_scheduler scheduler_t>
+    void schedule(scheduler_t scheduler,
+                  schedule_hints_t hints,
+                  std::stop_token stop_token = {})
     {
       CF_PROFILE_SCOPE();
-      get_promise().schedule_callback =
-          [p_scheduler = scheduler](std::function<void()> handle)
-      {
-        auto task_call = [p_handle = handle]() { p_handle(); };
-        tag_invoke(schedule_task_t{}, p_scheduler, std::move(task_call));
-      };
+      get_promise().context.stop_token = std::move(stop_token);
+      __details::submit_task(scheduler,
+                             prepare_schedule(scheduler, hints),
+                             hints);
+      m_coro_handle = {};
+    }
+    /**
+     * Prepares the coroutine to be a top level coroutine. The returned
+     * callback starts it. Until it's scheduled the task still owns the
+     * coroutine.
+     */
+    template <task_scheduler scheduler_t>
+    std::function<void()> prepare_schedule(const scheduler_t& scheduler,
+                                           schedule_hints_t hints)
+    {
+      get_promise().context.set_scheduler(scheduler);
+      get_promise().context.hints = hints;
+      return prepare_start();
+    }
+    // The context of the coroutine has to be set already.
+    std::function<void()> prepare_start()
+    {
       m_coro_handle.promise().execute_extension = true;
-      m_coro_handle.promise().external_referenced = keep_handle_alive;
+      m_coro_handle.promise().external_referenced = false;
       m_result_future =
           m_coro_handle.promise().extension.result_promise->get_future();
-      tag_invoke(schedule_task_t{},
-                 scheduler,
-                 [p_current_handle = m_coro_handle] { p_current_handle(); });
-      return std::exchange(m_coro_handle, {});
+      return __details::make_resume_callback(__details::start_callback_t{
+          [p_current_handle = m_coro_handle] { p_current_handle(); },
+          &m_coro_handle.promise().shed_requested });
     }
 
+    /**
+     * Prepares the coroutine to be co_awaited by the coroutine of
+     * suspended_promise, it inherits the context. The returned awaiter starts
+     * it.
+     */
     template <__details::coroutine_chain_holder other_promise_t>
-    awaiter_t<other_promise_t> run_async_impl(
-        std::function<void(std::function<void()>)> schedule_callback,
-        other_promise_t* suspended_promise);
+    awaiter_t<other_promise_t>
+        run_async_impl(const __details::task_context_t& context,
+                       other_promise_t* suspended_promise);
 
     promise_t& get_promise() { return m_coro_handle.promise(); }
     handle_t m_coro_handle;
     std::future<T> m_result_future;
 };
 
-template <typename T, typename scheduler_t>
-  requires(
-      std::copyable<scheduler_t> &&
-      is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>>)
+/**
+ * Starts the coroutine tree with a stop token. Every coroutine that it
+ * co_awaits inherits the token (see get_stop_token). After a stop request
+ * the coroutines that would start and the suspended library awaitables
+ * finish with operation_cancelled_error, thus the tree is unwound early.
+ */
+template <typename T, task_scheduler scheduler_t>
+void run_async(task<T>&& task,
+               scheduler_t scheduler,
+               schedule_hints_t hints,
+               std::stop_token stop_token)
+{
+  std::move(task).schedule(scheduler, hints, std::move(stop_token));
+}
+
+template <typename T, task_scheduler scheduler_t>
+void run_async(task<T>&& task,
+               scheduler_t scheduler,
+               std::stop_token stop_token)
+{
+  run_async(std::move(task),
+            std::move(scheduler),
+            schedule_hints_t{},
+            std::move(stop_token));
+}
+
+template <typename T, task_scheduler scheduler_t>
+void run_async(task<T>&& task, scheduler_t scheduler, schedule_hints_t hints)
+{
+  run_async(std::move(task), std::move(scheduler), hints, std::stop_token{});
+}
+
+template <typename T, task_scheduler scheduler_t>
 void run_async(task<T>&& task, scheduler_t scheduler)
 {
-  constexpr const bool keep_handle_alive = false;
-  std::move(task).schedule(scheduler, keep_handle_alive);
+  run_async(std::move(task), std::move(scheduler), schedule_hints_t{});
 }
 
-template <typename T, typename scheduler_t>
-  requires(
-      std::copyable<scheduler_t> &&
-      is_tag_invocable<schedule_task_t, scheduler_t, std::function<void()>>)
-T sync_wait(task<T>&& task, scheduler_t scheduler)
+namespace __details
 {
-  constexpr const bool keep_handle_alive = true;
+  /**
+   * Starts the coroutine as a top level coroutine with an inherited context,
+   * e.g. the child of a combinator that has to run independently of the
+   * awaiting coroutine. It destroys itself when it's finished, its result
+   * has to be passed on by the coroutine itself.
+   */
+  template <typename T>
+  void start_detached(task<T>&& task, const task_context_t& context)
+  {
+    CF_PROFILE_SCOPE();
+    task.get_promise().context = context;
+    std::function<void()> start = task.prepare_start();
+    task.m_coro_handle = {};
+    context.schedule(std::move(start));
+  }
 
-  auto handle = task.schedule(scheduler, keep_handle_alive);
-  assert(task.m_result_future.valid());
+  template <typename T>
+  struct is_task : std::false_type
+  {
+  };
+  template <typename T>
+  struct is_task<task<T>> : std::true_type
+  {
+  };
+} // namespace __details
 
-  try
+/**
+ * Starts every task of the range like run_async, but they are handed over to
+ * the scheduler in one batch (see schedule_bulk_t). The tasks are moved from.
+ */
+template <typename range_t, task_scheduler scheduler_t>
+void run_async_bulk(range_t&& tasks,
+                    scheduler_t scheduler,
+                    schedule_hints_t hints)
+{
+  using task_t = std::remove_cvref_t<std::ranges::range_reference_t<range_t>>;
+  static_assert(__details::is_task<task_t>::value,
+                "run_async_bulk expects a range of tasks.");
+  CF_PROFILE_SCOPE();
+  if constexpr (bulk_scheduler<scheduler_t>)
   {
-    [[maybe_unused]]
-    auto* handle_address = handle.address();
-    if constexpr (std::movable<T>)
+    std::vector<std::function<void()>> callbacks;
+    std::vector<std::coroutine_handle<>> handles;
+    if constexpr (std::ranges::sized_range<range_t>)
     {
-      auto result = std::move(task.m_result_future.get());
-      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
-                            task__sync_wait__has_result,
-                        handle_address);
-      handle.promise().internal_referenced.wait(true,
-                                                std::memory_order_acquire);
-      handle.destroy();
-      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
-                            task__sync_wait__handle_destroy,
-                        handle_address);
-      return std::move(result);
+      callbacks.reserve(std::ranges::size(tasks));
+      handles.reserve(std::ranges::size(tasks));
     }
-    else
+    try
     {
-      T result = task.m_result_future.get();
-      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
-                            task__sync_wait__has_result,
-                        handle_address);
-      handle.promise().internal_referenced.wait(true,
-                                                std::memory_order_acquire);
-      handle.destroy();
-      CF_TEST_INJECTION(__details::testing::test_injection_points_t::
-                            task__sync_wait__handle_destroy,
-                        handle_address);
-      return { result };
+      for (auto&& task : tasks)
+      {
+        callbacks.push_back(task.prepare_schedule(scheduler, hints));
+        handles.push_back(task.m_coro_handle);
+        task.m_coro_handle = {};
+      }
+      tag_invoke(schedule_bulk_t{}, scheduler, std::move(callbacks), hints);
+    }
+    catch (...)
+    {
+      // Nothing is scheduled (see schedule_bulk_t), the coroutines that
+      // were taken from the tasks are owned here.
+      for (auto handle : handles)
+      {
+        handle.destroy();
+      }
+      throw;
     }
   }
-  catch (...)
+  else
   {
-    handle.destroy();
-    std::rethrow_exception(std::current_exception());
+    for (auto&& task : tasks)
+    {
+      task.schedule(scheduler, hints);
+    }
   }
 }
 
+template <typename range_t, task_scheduler scheduler_t>
+void run_async_bulk(range_t&& tasks, scheduler_t scheduler)
+{
+  run_async_bulk(std::forward<range_t>(tasks),
+                 std::move(scheduler),
+                 schedule_hints_t{});
+}
+
+namespace __details
+{
+  /**
+   * Instead of blocking, the waiting thread executes the queued tasks of the
+   * scheduler until stop is requested on ready (the result is set), when the
+   * scheduler lets it. It prevents deadlocks when sync_wait is called from a
+   * worker.
+   */
+  template <task_scheduler scheduler_t>
+  void help_until_ready(const scheduler_t& scheduler, std::stop_token ready)
+  {
+    // Called from a coroutine the awaited work might be buffered
+    submit_buffer_t::instance().flush();
+    if constexpr (drivable_scheduler<scheduler_t>)
+    {
+      while (ready.stop_requested() == false)
+      {
+        if (tag_invoke(run_pending_task_t{}, scheduler, ready) == false)
+        {
+          return;
+        }
+      }
+    }
+  }
+} // namespace __details
+
+template <typename T, task_scheduler scheduler_t>
+T sync_wait(task<T>&& task, scheduler_t scheduler, schedule_hints_t hints)
+{
+  [[maybe_unused]]
+  auto* handle_address = task.address();
+  std::stop_source ready;
+  task.get_promise().extension.ready_source = ready;
+  task.schedule(scheduler, hints);
+  assert(task.m_result_future.valid());
+  __details::help_until_ready(scheduler, ready.get_token());
+
+  // The coroutine destroys itself after it provided the result.
+  if constexpr (std::movable<T>)
+  {
+    auto result = std::move(task.m_result_future.get());
+    CF_TEST_INJECTION(__details::testing::test_injection_points_t::
+                          task__sync_wait__has_result,
+                      handle_address);
+    return std::move(result);
+  }
+  else
+  {
+    T result = task.m_result_future.get();
+    CF_TEST_INJECTION(__details::testing::test_injection_points_t::
+                          task__sync_wait__has_result,
+                      handle_address);
+    return { result };
+  }
+}
+
+template <typename T, task_scheduler scheduler_t>
+T sync_wait(task<T>&& task, scheduler_t scheduler)
+{
+  return sync_wait(std::move(task), std::move(scheduler), schedule_hints_t{});
+}
+
 template <typename T>
 template <__details::coroutine_chain_holder other_promise_t>
-task<T>::awaiter_t<other_promise_t> task<T>::run_async_impl(
-    std::function<void(std::function<void()>)> schedule_callback,
-    other_promise_t* suspended_promise)
+task<T>::awaiter_t<other_promise_t>
+    task<T>::run_async_impl(const __details::task_context_t& context,
+                            other_promise_t* suspended_promise)
 {
-  using injection_point = __details::testing::test_injection_points_t;
   CF_PROFILE_SCOPE();
   m_coro_handle.promise().external_referenced = false;
 
-  get_promise().schedule_callback = schedule_callback;
+  get_promise().context = context;
+  get_promise().context.hopped = false;
 
-  suspended_promise->suspended_handle_resumed.clear();
   suspended_promise->internal_referenced.test_and_set(
       std::memory_order_release);
-  suspended_promise->suspend_started.clear(std::memory_order_release);
-
-  schedule_callback(
-      [p_coro_handle = m_coro_handle,
-       p_this_ptr = this,
-       p_suspended_promise = suspended_promise]() mutable
-      {
-        CF_PROFILE_SCOPE_N("Task::AsyncRun");
-        CF_ATTACH_NOTE("Executed handle", p_coro_handle.address());
-        CF_ATTACH_NOTE("Context's handle",
-                       std::coroutine_handle<other_promise_t>::from_promise(
-                           *p_suspended_promise)
-                           .address());
-
-        p_coro_handle();
-        CF_TEST_INJECTION(injection_point::task__run_async__async_call_finished,
-                          p_coro_handle.address());
-        CF_TEST_INJECTION(injection_point::task__run_async__before_test_and_set,
-                          std::coroutine_handle<other_promise_t>::from_promise(
-                              *p_suspended_promise)
-                              .address());
-        /*
-        It is a tricky problem what if when this function call blocks the
-        co_await so it never start to awaiting, thus suspended never gonna be
-        stored. In this situation continue_suspended_handle() can't be called,
-        because it will be a deadlock. We need to say somehow that co_await is
-        really started. And when it is really started we can check weather the
-        suspended_handle resumed or not.
-        */
-        const bool suspended_is_resumed =
-            p_suspended_promise->suspended_handle_resumed.test_and_set(
-                std::memory_order_acq_rel);
-        const bool suspend_started = p_suspended_promise->suspend_started.test(
-            std::memory_order_acquire);
-        if (suspended_is_resumed || suspend_started == false)
-        {
-          CF_ATTACH_NOTE("suspended handle were not really suspended.");
-          return;
-        }
-        if (p_coro_handle.done())
-        {
-          CF_PROFILE_ZONE(HandleDone, "Handle Done");
-          auto destroy_coro_at_end =
-              __details::scope_exit_t{ [&]() noexcept
-                                       { p_coro_handle.destroy(); } };
-
-          p_suspended_promise->get_coroutine_chain()
-              .continue_suspended_handle();
-        }
-        else
-        {
-          p_suspended_promise->get_coroutine_chain().move_into(
-              p_coro_handle.promise().get_coroutine_chain());
-        }
-      });
 
   awaiter_t<other_promise_t> result;
   result.current_handle = std::exchange(m_coro_handle, {});
   result.suspended_handle =
       std::coroutine_handle<other_promise_t>::from_promise(*suspended_promise);
 
-  suspended_promise->suspend_started.test_and_set(std::memory_order_release);
   return result;
 }
 
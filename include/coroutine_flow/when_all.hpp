@@ -0,0 +1,220 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/__details/fan_in.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  // Every child is awaited, the first failure is rethrown at the end
+  struct when_all_finished_t
+  {
+      void operator()(fan_in_state_t& state,
+                      std::size_t index,
+                      std::exception_ptr exception) const
+      {
+        if (exception)
+        {
+          state.try_claim_first(index, std::move(exception));
+        }
+        state.arrive();
+      }
+  };
+
+  template <typename... Ts>
+  struct when_all_state_t : fan_in_state_t
+  {
+      when_all_state_t(cancellable_suspend_t::resumer_t resumer)
+          : fan_in_state_t(std::move(resumer), sizeof...(Ts))
+      {
+      }
+
+      std::tuple<std::optional<Ts>...> results;
+  };
+
+  template <typename T>
+  struct when_all_range_state_t : fan_in_state_t
+  {
+      when_all_range_state_t(cancellable_suspend_t::resumer_t resumer,
+                             std::size_t child_count)
+          : fan_in_state_t(std::move(resumer), child_count)
+          , results(std::make_unique<std::optional<T>[]>(child_count))
+      {
+      }
+
+      std::unique_ptr<std::optional<T>[]> results;
+  };
+
+  template <typename... Ts>
+  class when_all_awaitable_t
+  {
+    public:
+      explicit when_all_awaitable_t(task<Ts>&&... children)
+          : m_children(std::move(children)...)
+      {
+      }
+      // It's moved only before it's awaited, there's no state yet
+      when_all_awaitable_t(when_all_awaitable_t&& other) noexcept
+          : m_children(std::move(other.m_children))
+      {
+      }
+
+      bool await_ready() const noexcept { return sizeof...(Ts) == 0; }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        // The children are stopped through their token, they are joined
+        auto resumer = m_suspend.begin(std::move(suspended_task), false);
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        // The last child resumes the awaiting coroutine and doesn't touch
+        // the state afterwards, thus it can live in this awaitable.
+        when_all_state_t<Ts...>* state = &m_state.emplace(*resumer);
+        // Every child is started before the awaiting coroutine can continue
+        [&]<std::size_t... indices>(std::index_sequence<indices...>)
+        {
+          (start_detached(
+               run_fan_in_child(std::move(std::get<indices>(m_children)),
+                                state,
+                                &std::get<indices>(state->results),
+                                indices,
+                                when_all_finished_t{}),
+               resumer->context()),
+           ...);
+        }(std::index_sequence_for<Ts...>{});
+        return m_suspend.end();
+      }
+      std::tuple<Ts...> await_resume()
+      {
+        m_suspend.finish();
+        if constexpr (sizeof...(Ts) == 0)
+        {
+          return {};
+        }
+        else
+        {
+          if (m_state->exception())
+          {
+            std::rethrow_exception(m_state->exception());
+          }
+          return std::apply(
+              [](auto&... results)
+              { return std::tuple<Ts...>(std::move(*results)...); },
+              m_state->results);
+        }
+      }
+
+    private:
+      std::tuple<task<Ts>...> m_children;
+      cancellable_suspend_t m_suspend;
+      std::optional<when_all_state_t<Ts...>> m_state;
+  };
+
+  template <typename T>
+  class when_all_range_awaitable_t
+  {
+    public:
+      explicit when_all_range_awaitable_t(std::vector<task<T>> children)
+          : m_children(std::move(children))
+      {
+      }
+      // It's moved only before it's awaited, there's no state yet
+      when_all_range_awaitable_t(when_all_range_awaitable_t&& other) noexcept
+          : m_children(std::move(other.m_children))
+      {
+      }
+
+      bool await_ready() const noexcept { return m_children.empty(); }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        // The children are stopped through their token, they are joined
+        auto resumer = m_suspend.begin(std::move(suspended_task), false);
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        // Only the results are allocated, see when_all_awaitable_t
+        when_all_range_state_t<T>* state =
+            &m_state.emplace(*resumer, m_children.size());
+        for (std::size_t i = 0; i < m_children.size(); ++i)
+        {
+          start_detached(run_fan_in_child(std::move(m_children[i]),
+                                          state,
+                                          &state->results[i],
+                                          i,
+                                          when_all_finished_t{}),
+                         resumer->context());
+        }
+        return m_suspend.end();
+      }
+      std::vector<T> await_resume()
+      {
+        m_suspend.finish();
+        std::vector<T> values;
+        if (m_state.has_value() == false)
+        {
+          return values;
+        }
+        if (m_state->exception())
+        {
+          std::rethrow_exception(m_state->exception());
+        }
+        values.reserve(m_children.size());
+        for (std::size_t i = 0; i < m_children.size(); ++i)
+        {
+          values.push_back(std::move(*m_state->results[i]));
+        }
+        return values;
+      }
+
+    private:
+      std::vector<task<T>> m_children;
+      cancellable_suspend_t m_suspend;
+      std::optional<when_all_range_state_t<T>> m_state;
+  };
+} // namespace __details
+
+/**
+ * Awaits every coroutine concurrently: they are started at once on the
+ * scheduler of the awaiting coroutine, which is resumed once, when the last
+ * one is finished. When a child fails the first exception is rethrown after
+ * every child is finished. The children inherit the stop token: a stop
+ * request reaches them, and the awaiting coroutine gets
+ * operation_cancelled_error when the last one is finished.
+ *
+ * auto [user, orders] = co_await cf::when_all(fetch_user(), fetch_orders());
+ */
+template <typename... Ts>
+__details::when_all_awaitable_t<Ts...> when_all(task<Ts>&&... children)
+{
+  return __details::when_all_awaitable_t<Ts...>(std::move(children)...);
+}
+
+/**
+ * Same as the variadic when_all for a vector of coroutines, the results
+ * are in the order of the coroutines.
+ *
+ * std::vector<int> sizes = co_await cf::when_all(std::move(requests));
+ */
+template <typename T>
+__details::when_all_range_awaitable_t<T>
+    when_all(std::vector<task<T>> children)
+{
+  return __details::when_all_range_awaitable_t<T>(std::move(children));
+}
+} // namespace coroutine_flow
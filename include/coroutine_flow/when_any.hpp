@@ -0,0 +1,241 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/__details/fan_in.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace coroutine_flow
+{
+// Result of when_any over a vector: the index and the result of the winner
+template <typename T>
+struct when_any_result
+{
+    std::size_t index;
+    T value;
+};
+
+namespace __details
+{
+  // The first finished child wins, stop is requested for the others
+  struct when_any_finished_t
+  {
+      template <typename state_t>
+      void operator()(state_t& state,
+                      std::size_t index,
+                      std::exception_ptr exception) const
+      {
+        if (state.try_claim_first(index, std::move(exception)) == false)
+        {
+          return;
+        }
+        state.children_stop_source.request_stop();
+        state.resume();
+      }
+  };
+
+  template <typename... Ts>
+  struct when_any_state_t : fan_in_state_t
+  {
+      when_any_state_t(cancellable_suspend_t::resumer_t resumer)
+          : fan_in_state_t(std::move(resumer), sizeof...(Ts))
+      {
+      }
+
+      std::stop_source children_stop_source;
+      std::tuple<std::optional<Ts>...> results;
+  };
+
+  template <typename T>
+  struct when_any_range_state_t : fan_in_state_t
+  {
+      when_any_range_state_t(cancellable_suspend_t::resumer_t resumer,
+                             std::size_t child_count)
+          : fan_in_state_t(std::move(resumer), child_count)
+          , results(child_count)
+      {
+      }
+
+      std::stop_source children_stop_source;
+      std::vector<std::optional<T>> results;
+  };
+
+  /**
+   * The children get their own stop token, it's stopped by the winner or
+   * when stop is requested for the awaiting coroutine.
+   */
+  template <typename state_t>
+  task_context_t make_when_any_context(
+      const std::shared_ptr<state_t>& state,
+      const cancellable_suspend_t::resumer_t& resumer)
+  {
+    resumer.set_on_cancel([p_state = state]
+                          { p_state->children_stop_source.request_stop(); });
+    task_context_t children_context = resumer.context();
+    children_context.stop_token = state->children_stop_source.get_token();
+    return children_context;
+  }
+
+  template <typename... Ts>
+  class when_any_awaitable_t
+  {
+      using state_t = when_any_state_t<Ts...>;
+
+    public:
+      using result_t = std::variant<Ts...>;
+
+      explicit when_any_awaitable_t(task<Ts>&&... children)
+          : m_children(std::move(children)...)
+      {
+      }
+
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        auto resumer = m_suspend.begin(std::move(suspended_task));
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        m_state = std::make_shared<state_t>(*resumer);
+        const task_context_t children_context =
+            make_when_any_context(m_state, *resumer);
+        [&]<std::size_t... indices>(std::index_sequence<indices...>)
+        {
+          (start_detached(
+               run_fan_in_child(std::move(std::get<indices>(m_children)),
+                                m_state,
+                                &std::get<indices>(m_state->results),
+                                indices,
+                                when_any_finished_t{}),
+               children_context),
+           ...);
+        }(std::index_sequence_for<Ts...>{});
+        return m_suspend.end();
+      }
+      result_t await_resume()
+      {
+        m_suspend.finish();
+        if (m_state->exception())
+        {
+          std::rethrow_exception(m_state->exception());
+        }
+        // The alternative of the winner is selected at runtime
+        return [&]<std::size_t... indices>(std::index_sequence<indices...>)
+        {
+          using take_t = result_t (*)(state_t&);
+          constexpr take_t c_take[] = { [](state_t& state)
+                                        {
+                                          return result_t(
+                                              std::in_place_index<indices>,
+                                              std::move(*std::get<indices>(
+                                                  state.results)));
+                                        }... };
+          return c_take[m_state->first_index()](*m_state);
+        }(std::index_sequence_for<Ts...>{});
+      }
+
+    private:
+      std::tuple<task<Ts>...> m_children;
+      cancellable_suspend_t m_suspend;
+      std::shared_ptr<state_t> m_state;
+  };
+
+  template <typename T>
+  class when_any_range_awaitable_t
+  {
+    public:
+      explicit when_any_range_awaitable_t(std::vector<task<T>> children)
+          : m_children(std::move(children))
+      {
+        assert(m_children.empty() == false);
+      }
+
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        auto resumer = m_suspend.begin(std::move(suspended_task));
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        m_state = std::make_shared<when_any_range_state_t<T>>(
+            *resumer,
+            m_children.size());
+        const task_context_t children_context =
+            make_when_any_context(m_state, *resumer);
+        for (std::size_t i = 0; i < m_children.size(); ++i)
+        {
+          start_detached(run_fan_in_child(std::move(m_children[i]),
+                                          m_state,
+                                          &m_state->results[i],
+                                          i,
+                                          when_any_finished_t{}),
+                         children_context);
+        }
+        return m_suspend.end();
+      }
+      when_any_result<T> await_resume()
+      {
+        m_suspend.finish();
+        if (m_state->exception())
+        {
+          std::rethrow_exception(m_state->exception());
+        }
+        const std::size_t index = m_state->first_index();
+        return when_any_result<T>{ index,
+                                   std::move(*m_state->results[index]) };
+      }
+
+    private:
+      std::vector<task<T>> m_children;
+      cancellable_suspend_t m_suspend;
+      std::shared_ptr<when_any_range_state_t<T>> m_state;
+  };
+} // namespace __details
+
+/**
+ * Runs the coroutines concurrently on the scheduler of the awaiting
+ * coroutine and continues it with the first finished one. The index of the
+ * returned variant tells which coroutine won, when the winner failed its
+ * exception is rethrown. Stop is requested for the others (see
+ * get_stop_token), they are abandoned and their frames are destroyed when
+ * they finish.
+ *
+ * auto result = co_await cf::when_any(lookup(replica_a), lookup(replica_b));
+ * const std::size_t winner = result.index();
+ */
+template <typename... Ts>
+__details::when_any_awaitable_t<Ts...> when_any(task<Ts>&&... children)
+{
+  static_assert(sizeof...(Ts) > 0, "when_any needs at least one coroutine");
+  return __details::when_any_awaitable_t<Ts...>(std::move(children)...);
+}
+
+/**
+ * Same as the variadic when_any for a non-empty vector of coroutines.
+ *
+ * cf::when_any_result<int> result = co_await cf::when_any(std::move(lookups));
+ */
+template <typename T>
+__details::when_any_range_awaitable_t<T>
+    when_any(std::vector<task<T>> children)
+{
+  return __details::when_any_range_awaitable_t<T>(std::move(children));
+}
+} // namespace coroutine_flow
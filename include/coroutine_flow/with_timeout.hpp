@@ -0,0 +1,187 @@
+#pragma once
+
+#include <coroutine_flow/__details/cancellable_suspend.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/__details/task_context.hpp>
+#include <coroutine_flow/__details/timer_service.hpp>
+#include <coroutine_flow/profiler.hpp>
+#include <coroutine_flow/schedule_task.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+
+namespace coroutine_flow
+{
+// The awaited coroutine didn't finish in time (see with_timeout)
+struct timeout_error
+{
+    bool operator==(const timeout_error&) const = default;
+};
+
+namespace __details
+{
+  /**
+   * Shared by the awaiting coroutine, the timer and the child. The first of
+   * the timer and the child finishes the wait, the other one is ignored.
+   */
+  template <typename T>
+  struct with_timeout_state_t
+  {
+      explicit with_timeout_state_t(cancellable_suspend_t::resumer_t resumer)
+          : resumer(std::move(resumer))
+      {
+      }
+
+      bool try_finish() noexcept
+      {
+        return finished.exchange(true, std::memory_order_acq_rel) == false;
+      }
+      void on_timeout()
+      {
+        if (try_finish() == false)
+        {
+          return;
+        }
+        timed_out = true;
+        // The child is abandoned, it can stop early
+        child_stop_source.request_stop();
+        resumer.resume_inline();
+      }
+      void on_child_finished(std::optional<T> value,
+                             std::exception_ptr exception)
+      {
+        if (try_finish() == false)
+        {
+          return;
+        }
+        result = std::move(value);
+        error = std::move(exception);
+        if (timer.has_value())
+        {
+          timer_service_t::instance().cancel(*timer);
+        }
+        resumer.resume();
+      }
+
+      cancellable_suspend_t::resumer_t resumer;
+      std::stop_source child_stop_source;
+      std::optional<timer_id_t> timer;
+      std::atomic_bool finished{ false };
+      bool timed_out{ false };
+      std::optional<T> result;
+      std::exception_ptr error;
+  };
+
+  // The child runs detached, it reports its result itself.
+  template <typename T>
+  task<int> run_with_timeout(task<T> child,
+                             std::shared_ptr<with_timeout_state_t<T>> state)
+  {
+    std::optional<T> value;
+    std::exception_ptr exception;
+    try
+    {
+      value.emplace(co_await std::move(child));
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+    state->on_child_finished(std::move(value), std::move(exception));
+    co_return 0;
+  }
+
+  template <typename T>
+  class with_timeout_awaitable_t
+  {
+    public:
+      with_timeout_awaitable_t(task<T>&& child,
+                               timer_clock_t::time_point deadline)
+          : m_child(std::move(child))
+          , m_deadline(deadline)
+      {
+      }
+
+      bool await_ready() const
+      {
+        return m_deadline <= timer_clock_t::now();
+      }
+      bool await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        auto resumer = m_suspend.begin(std::move(suspended_task));
+        if (resumer.has_value() == false)
+        {
+          return false;
+        }
+        m_state = std::make_shared<with_timeout_state_t<T>>(*resumer);
+        const task_context_t& context = resumer->context();
+        m_state->timer = context.schedule_at(
+            [p_state = m_state] { p_state->on_timeout(); }, m_deadline);
+
+        task_context_t child_context = context;
+        child_context.stop_token = m_state->child_stop_source.get_token();
+        resumer->set_on_cancel(
+            [p_state = m_state]
+            {
+              p_state->child_stop_source.request_stop();
+              if (p_state->timer.has_value())
+              {
+                timer_service_t::instance().cancel(*p_state->timer);
+              }
+            });
+        start_detached(run_with_timeout(std::move(m_child), m_state),
+                       child_context);
+        return m_suspend.end();
+      }
+      std::expected<T, timeout_error> await_resume()
+      {
+        m_suspend.finish();
+        // Expired before it was started
+        if (m_state == nullptr || m_state->timed_out)
+        {
+          return std::unexpected(timeout_error{});
+        }
+        if (m_state->error)
+        {
+          std::rethrow_exception(m_state->error);
+        }
+        return std::move(*m_state->result);
+      }
+
+    private:
+      task<T> m_child;
+      timer_clock_t::time_point m_deadline;
+      cancellable_suspend_t m_suspend;
+      std::shared_ptr<with_timeout_state_t<T>> m_state;
+  };
+} // namespace __details
+
+/**
+ * Awaits the coroutine at most for the given time. When the time is over
+ * the awaiting coroutine continues with timeout_error even if the child is
+ * still running: the child is abandoned, stop is requested for it (see
+ * get_stop_token) and its frame is destroyed when it finishes. The child
+ * runs as a separate task on the scheduler of the awaiting coroutine.
+ *
+ * std::expected<int, cf::timeout_error> result =
+ *     co_await cf::with_timeout(fetch(), std::chrono::milliseconds(50));
+ */
+template <typename T, typename rep_t, typename period_t>
+__details::with_timeout_awaitable_t<T>
+    with_timeout(task<T>&& child,
+                 std::chrono::duration<rep_t, period_t> timeout)
+{
+  return __details::with_timeout_awaitable_t<T>(
+      std::move(child),
+      timer_clock_t::now() +
+          std::chrono::ceil<timer_clock_t::duration>(timeout));
+}
+} // namespace coroutine_flow
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <coroutine_flow/__details/resume_budget.hpp>
+#include <coroutine_flow/__details/suspended_task.hpp>
+#include <coroutine_flow/profiler.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace coroutine_flow
+{
+namespace __details
+{
+  struct yield_awaitable_t
+  {
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(suspended_task_t suspended_task)
+      {
+        CF_PROFILE_SCOPE();
+        suspended_task.resume();
+      }
+      void await_resume() const noexcept {}
+  };
+} // namespace __details
+
+/**
+ * Gives the worker back to the scheduler: the coroutine is continued by a
+ * newly scheduled task, thus the other tasks of the scheduler get a chance to
+ * run. Long CPU-bound coroutines should call it regularly.
+ *
+ * co_await cf::yield();
+ */
+inline __details::yield_awaitable_t yield() noexcept { return {}; }
+
+/**
+ * Number of the coroutines that can be resumed inline (e.g. the awaiting
+ * coroutine when its child finished) within one scheduled task. When it is
+ * exhausted the next continuation is scheduled instead. The budget is shared
+ * by every scheduler and it is at least 1.
+ */
+inline void set_inline_resume_budget(std::size_t budget) noexcept
+{
+  __details::inline_resume_budget().store(std::max<std::size_t>(budget, 1),
+                                          std::memory_order_relaxed);
+}
+inline std::size_t inline_resume_budget() noexcept
+{
+  return __details::inline_resume_budget().load(std::memory_order_relaxed);
+}
+} // namespace coroutine_flow
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <coroutine_flow/schedule_task.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace coroutine_flow::__details::testing
+{
+/**
+ * Executes the scheduled tasks inline and records the hints they were
+ * scheduled with, e.g. to check what the awaited coroutines inherit.
+ */
+struct recording_scheduler_t
+{
+    std::vector<schedule_hints_t> scheduled_with;
+
+    friend void tag_invoke(coroutine_flow::schedule_task_t,
+                           recording_scheduler_t* scheduler,
+                           std::function<void()> callback,
+                           const schedule_hints_t& hints)
+    {
+      scheduler->scheduled_with.push_back(hints);
+      callback();
+    }
+};
+} // namespace coroutine_flow::__details::testing
@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/async_cache.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Concurrent requests of a key are coalesced",
+                 "[async_cache]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    auto [release_event, release_token] = event_t::create("release");
+    std::atomic_int loads{ 0 };
+    cf::async_cache<std::string, int> cache(16);
+
+    auto fetch = [&](std::string key) -> cf::task<int>
+    {
+      ++loads;
+      REQUIRE(release_token.is_triggered(c_test_case_timeout));
+      co_return static_cast<int>(key.size());
+    };
+    auto request = [&]() -> cf::task<int>
+    {
+      co_return co_await cache.get_or_compute("key",
+                                              [&] { return fetch("key"); });
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      std::vector<cf::task<int>> requests;
+      for (int i = 0; i < 8; ++i)
+      {
+        requests.push_back(request());
+      }
+      release_event.trigger();
+      const std::vector<int> values =
+          co_await cf::when_all(std::move(requests));
+      co_return values == std::vector<int>(8, 3);
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(loads == 1);
+    const cf::async_cache_stats stats = cache.stats();
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.hits + stats.coalesced == 7);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Least recently used entries are evicted",
+                 "[async_cache]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int loads{ 0 };
+    // One shard, thus the eviction order is exact
+    cf::async_cache<int, int> cache(2, 1);
+
+    auto fetch = [&](int key) -> cf::task<int>
+    {
+      ++loads;
+      co_return key * 10;
+    };
+    auto get = [&](int key) -> cf::task<int>
+    {
+      co_return co_await cache.get_or_compute(key,
+                                              [&] { return fetch(key); });
+    };
+
+    REQUIRE(cf::sync_wait(get(1), &thread_pool) == 10);
+    REQUIRE(cf::sync_wait(get(2), &thread_pool) == 20);
+    // 1 becomes the most recently used, 2 is evicted by 3
+    REQUIRE(cf::sync_wait(get(1), &thread_pool) == 10);
+    REQUIRE(cf::sync_wait(get(3), &thread_pool) == 30);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(loads == 3);
+    REQUIRE(cf::sync_wait(get(1), &thread_pool) == 10);
+    REQUIRE(loads == 3);
+    REQUIRE(cf::sync_wait(get(2), &thread_pool) == 20);
+    REQUIRE(loads == 4);
+
+    const cf::async_cache_stats stats = cache.stats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.evictions == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Failed loads are not cached",
+                 "[async_cache]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int loads{ 0 };
+    cf::async_cache<int, int> cache(16);
+
+    auto fetch = [&]() -> cf::task<int>
+    {
+      if (++loads == 1)
+      {
+        throw test_exception_t{};
+      }
+      co_return 42;
+    };
+    auto get = [&]() -> cf::task<int>
+    {
+      co_return co_await cache.get_or_compute(0, [&] { return fetch(); });
+    };
+
+    REQUIRE_THROWS_AS(cf::sync_wait(get(), &thread_pool), test_exception_t);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cf::sync_wait(get(), &thread_pool) == 42);
+    REQUIRE(loads == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "In flight loads are not evicted",
+                 "[async_cache]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int loads{ 0 };
+    cf::async_cache<int, int> cache(1, 1);
+
+    auto fetch = [&](int key) -> cf::task<int>
+    {
+      ++loads;
+      co_return key * 10;
+    };
+    auto get = [&](int key) -> cf::task<int>
+    {
+      co_return co_await cache.get_or_compute(key,
+                                              [&] { return fetch(key); });
+    };
+
+    // Not awaited yet, the load of 1 is in flight
+    auto pending = cache.get_or_compute(1, [&] { return fetch(1); });
+    REQUIRE(cf::sync_wait(get(2), &thread_pool) == 20);
+    REQUIRE(cf::sync_wait(get(3), &thread_pool) == 30);
+    REQUIRE(cache.size() == 2);
+    // The request joins the load, it isn't started again
+    auto joined = cache.get_or_compute(1, [&] { return fetch(1); });
+    auto await_loads = [&]() -> cf::task<int>
+    {
+      const int first = co_await pending;
+      co_return first + co_await joined;
+    };
+    REQUIRE(cf::sync_wait(await_loads(), &thread_pool) == 20);
+    REQUIRE(loads == 3);
+
+    // The finished values are evicted at the next miss
+    REQUIRE(cf::sync_wait(get(4), &thread_pool) == 40);
+    REQUIRE(cache.size() == 1);
+    const cf::async_cache_stats stats = cache.stats();
+    REQUIRE(stats.coalesced == 1);
+    REQUIRE(stats.evictions == 3);
+  }
+  memory_checker.check();
+}
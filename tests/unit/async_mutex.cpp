@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+
+#include <coroutine_flow/async_mutex.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Critical sections don't overlap",
+                 "[async_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::async_mutex mutex;
+    int counter = 0;
+    std::atomic_int inside{ 0 };
+
+    auto critical_section = [&](bool suspend) -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock();
+      REQUIRE(++inside == 1);
+      const int value = counter;
+      if (suspend)
+      {
+        // Suspends while the lock is held
+        co_await cf::sleep_for(100us);
+      }
+      counter = value + 1;
+      --inside;
+      co_return 0;
+    };
+    auto increment = [&]() -> cf::task<int>
+    {
+      for (int i = 0; i < 100; ++i)
+      {
+        // Locked by a child coroutine that can finish on another thread
+        co_await critical_section(i % 10 == 0);
+      }
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> workers;
+      for (int i = 0; i < 8; ++i)
+      {
+        workers.push_back(increment());
+      }
+      co_await cf::when_all(std::move(workers));
+      co_return counter;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 800);
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Lock is handed over in arrival order",
+                 "[async_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    // One worker, thus the waiters arrive in the order they are started
+    cf::schedulers::priority_thread_pool_t thread_pool(1);
+    cf::async_mutex mutex;
+    std::vector<int> order;
+
+    auto waiter = [&](int id) -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock();
+      order.push_back(id);
+      co_return id;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      mutex.unlock();
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      REQUIRE(mutex.try_lock());
+      co_await cf::when_all(waiter(1), waiter(2), waiter(3), releaser());
+      co_return 0;
+    };
+
+    cf::sync_wait(coro(), &thread_pool);
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Waiting for the lock doesn't block the worker",
+                 "[async_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(1);
+    cf::async_mutex mutex;
+    std::atomic_bool other_work_done{ false };
+    std::atomic_bool waiter_locked{ false };
+
+    auto holder = [&]() -> cf::task<bool>
+    {
+      auto lock = co_await mutex.lock();
+      co_await cf::sleep_for(20ms);
+      co_return other_work_done && waiter_locked == false;
+    };
+    auto waiter = [&]() -> cf::task<bool>
+    {
+      auto lock = co_await mutex.lock();
+      waiter_locked = true;
+      co_return true;
+    };
+    auto other_work = [&]() -> cf::task<bool>
+    {
+      other_work_done = true;
+      co_return true;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [holder_result, waiter_result, other_result] =
+          co_await cf::when_all(holder(), waiter(), other_work());
+      co_return holder_result && waiter_result && other_result;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+  }
+  memory_checker.check();
+}
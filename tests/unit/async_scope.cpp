@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/async_scope.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "join_sync waits for every spawned coroutine",
+                 "[async_scope]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int finished{ 0 };
+
+    auto work = [&](bool should_throw) -> cf::task<int>
+    {
+      co_await cf::sleep_for(5ms);
+      ++finished;
+      if (should_throw)
+      {
+        throw test_exception_t{};
+      }
+      co_return 0;
+    };
+
+    cf::async_scope scope;
+    REQUIRE(scope.in_flight() == 0);
+    // An empty scope is joined immediately
+    scope.join_sync();
+    for (int i = 0; i < 10; ++i)
+    {
+      scope.spawn(work(i % 3 == 0), &thread_pool);
+    }
+    scope.join_sync();
+    REQUIRE(finished == 10);
+    REQUIRE(scope.in_flight() == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "join continues the awaiting coroutine",
+                 "[async_scope]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    auto [release_event, release_token] = event_t::create("release");
+    std::atomic_int finished{ 0 };
+
+    auto blocked = [&]() -> cf::task<int>
+    {
+      REQUIRE(release_token.is_triggered(c_test_case_timeout));
+      ++finished;
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      cf::async_scope scope;
+      scope.spawn(blocked(), &thread_pool);
+      scope.spawn(blocked(), &thread_pool);
+      release_event.trigger();
+      co_await scope.join();
+      co_return finished.load();
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "request_stop cancels the spawned coroutines",
+                 "[async_scope]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int cancelled{ 0 };
+
+    auto sleeping = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await cf::sleep_for(1h);
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled;
+        throw;
+      }
+      co_return 0;
+    };
+
+    cf::async_scope scope;
+    scope.spawn(sleeping(), &thread_pool);
+    scope.spawn(sleeping(), &thread_pool);
+    scope.request_stop();
+    // It's not started at all, but it's still accounted
+    scope.spawn(sleeping(), &thread_pool);
+    scope.join_sync();
+    REQUIRE(cancelled <= 2);
+    REQUIRE(scope.in_flight() == 0);
+  }
+  memory_checker.check();
+}
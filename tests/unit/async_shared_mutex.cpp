@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+
+#include <coroutine_flow/async_latch.hpp>
+#include <coroutine_flow/async_shared_mutex.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Writers exclude everybody, readers only the writers",
+                 "[async_shared_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::async_shared_mutex mutex;
+    int value = 0;
+    std::atomic_int readers_inside{ 0 };
+    std::atomic_int writers_inside{ 0 };
+    std::atomic_bool overlapped{ false };
+
+    auto reader = [&]() -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock_shared();
+      ++readers_inside;
+      overlapped = overlapped || writers_inside != 0;
+      const int result = value;
+      --readers_inside;
+      co_return result;
+    };
+    auto writer = [&](bool suspend) -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock();
+      overlapped =
+          overlapped || ++writers_inside != 1 || readers_inside != 0;
+      const int current = value;
+      if (suspend)
+      {
+        // Suspends while the lock is held
+        co_await cf::sleep_for(100us);
+      }
+      value = current + 1;
+      --writers_inside;
+      co_return 0;
+    };
+    auto worker = [&](int id) -> cf::task<int>
+    {
+      for (int i = 0; i < 200; ++i)
+      {
+        if ((i + id) % 20 == 0)
+        {
+          co_await writer(i % 40 == 0);
+        }
+        else
+        {
+          co_await reader();
+        }
+      }
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> workers;
+      for (int i = 0; i < 8; ++i)
+      {
+        workers.push_back(worker(i));
+      }
+      co_await cf::when_all(std::move(workers));
+      co_return value;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 8 * 10);
+    REQUIRE(overlapped == false);
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Waiting writer stops the new readers",
+                 "[async_shared_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    // One worker, thus the coroutines arrive in the order they are started
+    cf::schedulers::priority_thread_pool_t thread_pool(1);
+    cf::async_shared_mutex mutex;
+    std::vector<int> order;
+
+    auto writer = [&]() -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock();
+      order.push_back(1);
+      co_return 0;
+    };
+    auto late_reader = [&]() -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock_shared();
+      order.push_back(2);
+      co_return 0;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      mutex.unlock_shared();
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      REQUIRE(mutex.try_lock_shared());
+      co_await cf::when_all(writer(), late_reader(), releaser());
+      co_return 0;
+    };
+
+    cf::sync_wait(coro(), &thread_pool);
+    REQUIRE(order == std::vector<int>{ 1, 2 });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Unlocking the writer lets in every waiting reader",
+                 "[async_shared_mutex]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_shared_mutex mutex;
+    cf::async_latch readers_inside(3);
+
+    auto reader = [&]() -> cf::task<int>
+    {
+      auto lock = co_await mutex.lock_shared();
+      // Returns only when all of the readers hold the lock
+      readers_inside.count_down();
+      co_await readers_inside.wait();
+      co_return 1;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      co_await cf::sleep_for(10ms);
+      mutex.unlock();
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      REQUIRE(mutex.try_lock());
+      REQUIRE(mutex.try_lock_shared() == false);
+      auto [first, second, third, released] =
+          co_await cf::when_all(reader(), reader(), reader(), releaser());
+      co_return first + second + third;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 3);
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/inline_scheduler.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/blocking.hpp>
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <future>
+#include <string>
+#include <thread>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::inline_scheduler_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Blocking operation runs outside of the scheduler",
+                 "[blocking]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    std::thread::id before;
+    std::thread::id blocking_thread;
+    std::thread::id after;
+    auto coro = [&]() -> cf::task<std::string>
+    {
+      before = std::this_thread::get_id();
+      std::string result = co_await cf::blocking(
+          [&]
+          {
+            blocking_thread = std::this_thread::get_id();
+            return std::string{ "42" };
+          });
+      after = std::this_thread::get_id();
+      co_return result;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == "42");
+    REQUIRE(blocking_thread != before);
+    // The pool has only one worker, so it is resumed on the original one
+    REQUIRE(after == before);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Blocking operation doesn't occupy the worker",
+                 "[blocking]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    std::promise<void> released;
+    std::shared_future<void> released_future = released.get_future().share();
+    auto [finished_event, finished_token] = event_t::create("waiter finished");
+
+    auto waiter = [&]() -> cf::task<int>
+    {
+      co_await cf::blocking([&] { released_future.wait(); });
+      finished_event.trigger();
+      co_return 1;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      released.set_value();
+      co_return 2;
+    };
+
+    cf::run_async(waiter(), &thread_pool);
+    // Would be a deadlock if the waiter blocked the only worker
+    REQUIRE(cf::sync_wait(releaser(), &thread_pool) == 2);
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Exception of the blocking operation is propagated",
+                 "[blocking]")
+{
+  memory_check_t memory_checker;
+  {
+    inline_scheduler_t scheduler;
+    auto coro = []() -> cf::task<int>
+    {
+      co_await cf::blocking([] { throw test_exception_t{}; });
+      co_return 1;
+    };
+
+    REQUIRE_THROWS_AS(cf::sync_wait(coro(), &scheduler), test_exception_t);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Blocking operation inside nested coroutines",
+                 "[blocking]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 2, .max_threads = 2 });
+    cf::schedulers::elastic_thread_pool_t blocking_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    auto coro_1 = [&](int value) -> cf::task<int>
+    {
+      co_return co_await cf::blocking(
+          [=]
+          {
+            std::this_thread::sleep_for(1ms);
+            return value;
+          },
+          &blocking_pool);
+    };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      int result = co_await coro_1(1);
+      result += co_await coro_1(2);
+      co_return result;
+    };
+
+    REQUIRE(cf::sync_wait(coro_2(), &thread_pool) == 3);
+  }
+  memory_checker.check();
+}
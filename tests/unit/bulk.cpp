@@ -0,0 +1,229 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/strand.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <ranges>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+struct counting_scheduler_t
+{
+    cf::schedulers::priority_thread_pool_t* pool;
+    std::atomic_int* single_count;
+    std::atomic_int* bulk_count;
+};
+
+void tag_invoke(cf::schedule_task_t,
+                counting_scheduler_t scheduler,
+                std::function<void()> callback,
+                const cf::schedule_hints_t& hints)
+{
+  ++*scheduler.single_count;
+  cf::tag_invoke(cf::schedule_task_t{},
+                 scheduler.pool,
+                 std::move(callback),
+                 hints);
+}
+void tag_invoke(cf::schedule_bulk_t,
+                counting_scheduler_t scheduler,
+                std::vector<std::function<void()>> callbacks,
+                const cf::schedule_hints_t& hints)
+{
+  ++*scheduler.bulk_count;
+  cf::tag_invoke(cf::schedule_bulk_t{},
+                 scheduler.pool,
+                 std::move(callbacks),
+                 hints);
+}
+
+struct single_scheduler_t
+{
+    cf::schedulers::priority_thread_pool_t* pool;
+    std::atomic_int* single_count;
+};
+
+void tag_invoke(cf::schedule_task_t,
+                single_scheduler_t scheduler,
+                std::function<void()> callback)
+{
+  ++*scheduler.single_count;
+  cf::tag_invoke(cf::schedule_task_t{},
+                 scheduler.pool,
+                 std::move(callback),
+                 cf::schedule_hints_t{});
+}
+
+struct failing_scheduler_t
+{
+};
+
+void tag_invoke(cf::schedule_task_t, failing_scheduler_t, std::function<void()>)
+{
+  throw test_exception_t{};
+}
+void tag_invoke(cf::schedule_bulk_t,
+                failing_scheduler_t,
+                std::vector<std::function<void()>>,
+                const cf::schedule_hints_t&)
+{
+  throw test_exception_t{};
+}
+
+// Counts the finished tasks and triggers the event after the last one
+struct completion_t
+{
+    int expected;
+    std::atomic_int finished{ 0 };
+    event_t event;
+
+    void on_finished()
+    {
+      if (++finished == expected)
+      {
+        event.trigger();
+      }
+    }
+};
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Bulk tasks are scheduled in one batch",
+                 "[bulk]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    constexpr int c_task_count = 1000;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    completion_t completion{ c_task_count, 0, std::move(finished_event) };
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      const int result = co_await coro_1();
+      completion.on_finished();
+      co_return result;
+    };
+    std::vector<cf::task<int>> tasks;
+    for (int i = 0; i < c_task_count; ++i)
+    {
+      tasks.push_back(coro_2());
+    }
+    std::atomic_int single_count{ 0 };
+    std::atomic_int bulk_count{ 0 };
+    cf::run_async_bulk(
+        tasks,
+        counting_scheduler_t{ &thread_pool, &single_count, &bulk_count });
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(bulk_count == 1);
+    // Only the awaited coroutines are scheduled one by one
+    REQUIRE(single_count == c_task_count);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Bulk tasks fall back to one by one scheduling",
+                 "[bulk]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    constexpr int c_task_count = 100;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    completion_t completion{ c_task_count, 0, std::move(finished_event) };
+
+    auto coro = [&]() -> cf::task<int>
+    {
+      completion.on_finished();
+      co_return 1;
+    };
+    std::atomic_int single_count{ 0 };
+    cf::run_async_bulk(std::views::iota(0, c_task_count) |
+                           std::views::transform([&](int) { return coro(); }),
+                       single_scheduler_t{ &thread_pool, &single_count });
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(single_count == c_task_count);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Library schedulers accept bulk tasks",
+                 "[bulk]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 4 });
+    cf::strand<cf::schedulers::elastic_thread_pool_t*> strand(&thread_pool);
+    constexpr int c_task_count = 200;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    completion_t completion{ 2 * c_task_count, 0, std::move(finished_event) };
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      const int result = co_await coro_1();
+      completion.on_finished();
+      co_return result;
+    };
+    auto make_tasks = [&]
+    {
+      return std::views::iota(0, c_task_count) |
+             std::views::transform([&](int) { return coro_2(); });
+    };
+    cf::run_async_bulk(make_tasks(), &thread_pool);
+    cf::run_async_bulk(make_tasks(), strand);
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Bulk tasks are destroyed when the batch can't be scheduled",
+                 "[bulk]")
+{
+  memory_check_t memory_checker;
+  {
+    std::atomic_int executed{ 0 };
+    auto coro = [&]() -> cf::task<int>
+    {
+      ++executed;
+      co_return 1;
+    };
+    std::vector<cf::task<int>> tasks;
+    for (int i = 0; i < 10; ++i)
+    {
+      tasks.push_back(coro());
+    }
+    REQUIRE_THROWS_AS(cf::run_async_bulk(tasks, failing_scheduler_t{}),
+                      test_exception_t);
+    REQUIRE(executed == 0);
+  }
+  memory_checker.check();
+}
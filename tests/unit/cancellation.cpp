@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/cancellation.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stop_token>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Children inherit the stop token",
+                 "[cancellation]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::stop_source stop_source;
+    std::atomic_bool inherited{ false };
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto child = []() -> cf::task<std::stop_token>
+    { co_return co_await cf::get_stop_token(); };
+    auto coro = [&]() -> cf::task<int>
+    {
+      const std::stop_token stop_token = co_await child();
+      inherited = stop_token == stop_source.get_token();
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(inherited);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Stop request interrupts a sleep",
+                 "[cancellation]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::stop_source stop_source;
+    std::atomic_bool cancelled{ false };
+    auto [sleeping_event, sleeping_token] = event_t::create("sleeping");
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto child = [&]() -> cf::task<int>
+    {
+      sleeping_event.trigger();
+      co_await cf::sleep_for(1h);
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await child();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        cancelled = true;
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    REQUIRE(sleeping_token.is_triggered(c_test_case_timeout));
+    stop_source.request_stop();
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(cancelled);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Cancelled tree doesn't start new work",
+                 "[cancellation]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::stop_source stop_source;
+    std::atomic_int started_children{ 0 };
+    std::atomic_int cancelled_count{ 0 };
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto child = [&]() -> cf::task<int>
+    {
+      ++started_children;
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      stop_source.request_stop();
+      try
+      {
+        co_await child();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled_count;
+      }
+      try
+      {
+        co_await cf::sleep_for(1h);
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled_count;
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(started_children == 0);
+    REQUIRE(cancelled_count == 2);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,295 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/channel.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Every sent value is received once",
+                 "[channel]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::channel<int> channel(8);
+    constexpr int c_producers = 4;
+    constexpr int c_values = 250;
+
+    auto producer = [&](int id) -> cf::task<int>
+    {
+      for (int i = 1; i <= c_values; ++i)
+      {
+        REQUIRE(co_await channel.send(id * c_values + i));
+      }
+      co_return 0;
+    };
+    auto producers = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> tasks;
+      for (int i = 0; i < c_producers; ++i)
+      {
+        tasks.push_back(producer(i));
+      }
+      co_await cf::when_all(std::move(tasks));
+      channel.close();
+      co_return 0;
+    };
+    auto consumer = [&]() -> cf::task<long>
+    {
+      long sum = 0;
+      while (std::optional<int> value = co_await channel.receive())
+      {
+        sum += *value;
+      }
+      co_return sum;
+    };
+    auto coro = [&]() -> cf::task<long>
+    {
+      auto [produced, first, second, third] = co_await cf::when_all(
+          producers(), consumer(), consumer(), consumer());
+      co_return first + second + third;
+    };
+
+    constexpr long c_count = c_producers * c_values;
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == c_count * (c_count + 1) / 2);
+    REQUIRE(channel.try_send(1) == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Full channel suspends the sender",
+                 "[channel]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::channel<std::unique_ptr<int>> channel(2);
+    std::atomic_int sent{ 0 };
+
+    auto producer = [&]() -> cf::task<int>
+    {
+      for (int i = 0; i < 5; ++i)
+      {
+        co_await channel.send(std::make_unique<int>(i));
+        ++sent;
+      }
+      co_return 0;
+    };
+    auto consumer = [&]() -> cf::task<bool>
+    {
+      co_await cf::sleep_for(20ms);
+      // The producer waits for room
+      bool in_order = sent == 2;
+      for (int i = 0; i < 5; ++i)
+      {
+        std::optional<std::unique_ptr<int>> value = co_await channel.receive();
+        in_order = in_order && value.has_value() && **value == i;
+      }
+      co_return in_order;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [produced, in_order] = co_await cf::when_all(producer(), consumer());
+      co_return in_order;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(channel.try_receive().has_value() == false);
+    auto value = std::make_unique<int>(5);
+    REQUIRE(channel.try_send(std::move(value)));
+    REQUIRE(channel.try_send(std::make_unique<int>(6)));
+    value = std::make_unique<int>(7);
+    // Not sent, the value is kept
+    REQUIRE(channel.try_send(std::move(value)) == false);
+    REQUIRE(value != nullptr);
+    REQUIRE(**channel.try_receive() == 5);
+    REQUIRE(**channel.try_receive() == 6);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Closing continues the waiters",
+                 "[channel]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::channel<int> channel(1);
+    cf::channel<int> full_channel(1);
+    REQUIRE(full_channel.try_send(1));
+
+    auto receiver = [&]() -> cf::task<bool>
+    {
+      co_return (co_await channel.receive()).has_value();
+    };
+    auto sender = [&]() -> cf::task<bool>
+    {
+      co_return co_await full_channel.send(2);
+    };
+    auto closer = [&]() -> cf::task<bool>
+    {
+      co_await cf::sleep_for(10ms);
+      channel.close();
+      full_channel.close();
+      co_return true;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [received, sent, closed] =
+          co_await cf::when_all(receiver(), sender(), closer());
+      co_return received == false && sent == false && closed;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    // The buffered value is still received
+    REQUIRE(full_channel.try_receive() == 1);
+    REQUIRE(full_channel.try_receive().has_value() == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Single producer single consumer pipeline keeps the order",
+                 "[channel]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::spsc_channel<int> numbers(4);
+    cf::spsc_channel<int> squares(4);
+    constexpr int c_values = 1'000;
+
+    auto produce = [&]() -> cf::task<int>
+    {
+      for (int i = 0; i < c_values; ++i)
+      {
+        co_await numbers.send(i);
+      }
+      numbers.close();
+      co_return 0;
+    };
+    auto square = [&]() -> cf::task<int>
+    {
+      while (std::optional<int> value = co_await numbers.receive())
+      {
+        co_await squares.send(*value * *value);
+      }
+      squares.close();
+      co_return 0;
+    };
+    auto consume = [&]() -> cf::task<bool>
+    {
+      int expected = 0;
+      bool in_order = true;
+      while (std::optional<int> value = co_await squares.receive())
+      {
+        in_order = in_order && *value == expected * expected;
+        ++expected;
+      }
+      co_return in_order && expected == c_values;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [produced, squared, in_order] =
+          co_await cf::when_all(produce(), square(), consume());
+      co_return in_order;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Stop request cancels a blocked send and a blocked receive",
+                 "[channel]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::channel<int> full(1);
+    cf::channel<int> empty(1);
+    std::stop_source sender_stop;
+    std::stop_source receiver_stop;
+    std::atomic_bool send_cancelled{ false };
+    std::atomic_bool receive_cancelled{ false };
+    auto [waiting_event, waiting_token] = event_t::create("waiting");
+    auto [sent_event, sent_token] = event_t::create("sent");
+    auto [received_event, received_token] = event_t::create("received");
+
+    REQUIRE(full.try_send(1));
+    auto sender = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await full.send(2);
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        send_cancelled = true;
+      }
+      sent_event.trigger();
+      co_return 0;
+    };
+    auto receiver = [&]() -> cf::task<int>
+    {
+      waiting_event.trigger();
+      try
+      {
+        co_await empty.receive();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        receive_cancelled = true;
+      }
+      received_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(sender(), &thread_pool, sender_stop.get_token());
+    cf::run_async(receiver(), &thread_pool, receiver_stop.get_token());
+
+    REQUIRE(waiting_token.is_triggered(c_test_case_timeout));
+    std::this_thread::sleep_for(10ms);
+    sender_stop.request_stop();
+    REQUIRE(sent_token.is_triggered(c_test_case_timeout));
+    REQUIRE(send_cancelled);
+    receiver_stop.request_stop();
+    REQUIRE(received_token.is_triggered(c_test_case_timeout));
+    REQUIRE(receive_cancelled);
+
+    // The cancelled sender's value is dropped, the waiters left the queues
+    REQUIRE(full.try_receive() == 1);
+    REQUIRE(full.try_receive().has_value() == false);
+    REQUIRE(empty.try_send(3));
+    REQUIRE(empty.try_receive() == 3);
+  }
+  memory_checker.check();
+}
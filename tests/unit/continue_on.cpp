@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/recording_scheduler.hpp>
+
+#include <coroutine_flow/continue_on.hpp>
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::recording_scheduler_t;
+
+namespace
+{
+std::thread::id worker_of(cf::schedulers::elastic_thread_pool_t* pool)
+{
+  auto coro = []() -> cf::task<std::thread::id>
+  { co_return std::this_thread::get_id(); };
+  return cf::sync_wait(coro(), pool);
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Coroutine hops between schedulers",
+                 "[continue_on]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t io_pool(
+        { .min_threads = 1, .max_threads = 1 });
+    cf::schedulers::elastic_thread_pool_t cpu_pool(
+        { .min_threads = 1, .max_threads = 1 });
+    const std::thread::id io_thread = worker_of(&io_pool);
+    const std::thread::id cpu_thread = worker_of(&cpu_pool);
+
+    std::vector<std::thread::id> threads;
+    auto child = [&]() -> cf::task<int>
+    {
+      threads.push_back(std::this_thread::get_id());
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      threads.push_back(std::this_thread::get_id());
+      co_await cf::continue_on(&cpu_pool);
+      threads.push_back(std::this_thread::get_id());
+      // Inherits the new scheduler
+      int result = co_await child();
+      threads.push_back(std::this_thread::get_id());
+      co_await cf::continue_on(&io_pool);
+      threads.push_back(std::this_thread::get_id());
+      result += co_await child();
+      co_return result;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &io_pool) == 2);
+    REQUIRE(threads == std::vector<std::thread::id>{ io_thread,
+                                                     cpu_thread,
+                                                     cpu_thread,
+                                                     cpu_thread,
+                                                     io_thread,
+                                                     io_thread });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Nested coroutine hops, its parent stays on its scheduler",
+                 "[continue_on]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t io_pool(
+        { .min_threads = 1, .max_threads = 1 });
+    cf::schedulers::elastic_thread_pool_t cpu_pool(
+        { .min_threads = 1, .max_threads = 1 });
+    const std::thread::id io_thread = worker_of(&io_pool);
+    const std::thread::id cpu_thread = worker_of(&cpu_pool);
+
+    // The hop is in the first slice of the child
+    auto child = [&]() -> cf::task<std::thread::id>
+    {
+      co_await cf::continue_on(&cpu_pool);
+      co_return std::this_thread::get_id();
+    };
+    auto coro = [&]() -> cf::task<std::vector<std::thread::id>>
+    {
+      std::vector<std::thread::id> result;
+      result.push_back(co_await child());
+      // The child finished on the cpu pool, its parent is continued on its
+      // own scheduler
+      result.push_back(std::this_thread::get_id());
+      co_return result;
+    };
+
+    for (int i = 0; i < 100; ++i)
+    {
+      REQUIRE(cf::sync_wait(coro(), &io_pool) ==
+              std::vector<std::thread::id>{ cpu_thread, io_thread });
+    }
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Hints are kept after the hop",
+                 "[continue_on]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(1);
+    recording_scheduler_t scheduler;
+
+    auto child = []() -> cf::task<int> { co_return 1; };
+    auto coro = [&]() -> cf::task<int>
+    {
+      co_await cf::continue_on(&scheduler);
+      co_return co_await child();
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool, cf::priority_t::high) == 1);
+    // The hop and the child
+    REQUIRE(scheduler.scheduled_with.size() == 2);
+    for (const auto& hints : scheduler.scheduled_with)
+    {
+      REQUIRE(hints.priority == cf::priority_t::high);
+    }
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/recording_scheduler.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/edf_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::recording_scheduler_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Deadline is inherited by the awaited coroutines",
+                 "[deadline]")
+{
+  memory_check_t memory_checker;
+  {
+    recording_scheduler_t scheduler;
+    const cf::deadline_t deadline = cf::deadline_clock_t::now() + 1h;
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int> { co_return co_await coro_1(); };
+
+    REQUIRE(cf::sync_wait(coro_2(), &scheduler, deadline) == 1);
+    REQUIRE(scheduler.scheduled_with ==
+            std::vector<cf::schedule_hints_t>{ deadline, deadline });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Earliest deadline is executed first",
+                 "[deadline]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::edf_thread_pool_t thread_pool(1);
+
+    std::promise<void> release_worker;
+    auto blocker = [](std::shared_future<void> released) -> cf::task<int>
+    {
+      released.wait();
+      co_return 0;
+    };
+    cf::run_async(blocker(release_worker.get_future().share()), &thread_pool);
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    auto record = [&](int id) -> cf::task<int>
+    {
+      std::lock_guard lock(order_mutex);
+      order.push_back(id);
+      if (order.size() == 4)
+      {
+        finished_event.trigger();
+      }
+      co_return id;
+    };
+    const auto now = cf::deadline_clock_t::now();
+    cf::run_async(record(1), &thread_pool);
+    cf::run_async(record(2), &thread_pool, now + 3h);
+    cf::run_async(record(3), &thread_pool, now + 1h);
+    cf::run_async(record(4), &thread_pool, now + 2h);
+
+    release_worker.set_value();
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    std::lock_guard lock(order_mutex);
+    REQUIRE(order == std::vector<int>{ 3, 4, 2, 1 });
+    REQUIRE(thread_pool.missed_count() == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Late tasks are counted and executed by default",
+                 "[deadline]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::edf_thread_pool_t thread_pool(1);
+    auto coro = []() -> cf::task<int> { co_return 1; };
+
+    const auto deadline = cf::deadline_clock_t::now() - 1ms;
+    REQUIRE(cf::sync_wait(coro(), &thread_pool, deadline) == 1);
+    REQUIRE(thread_pool.missed_count() == 1);
+    REQUIRE(thread_pool.shed_count() == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Late coroutines are shed without executing them",
+                 "[deadline]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::edf_thread_pool_t thread_pool(
+        1,
+        cf::deadline_miss_policy_t::shed);
+    bool child_executed = false;
+    auto child = [&]() -> cf::task<int>
+    {
+      child_executed = true;
+      co_return 1;
+    };
+    auto parent = [&]() -> cf::task<int>
+    {
+      std::this_thread::sleep_for(100ms);
+      try
+      {
+        co_return co_await child();
+      }
+      catch (const cf::deadline_exceeded_error&)
+      {
+        co_return -1;
+      }
+    };
+
+    const auto deadline = cf::deadline_clock_t::now() + 50ms;
+    REQUIRE(cf::sync_wait(parent(), &thread_pool, deadline) == -1);
+    REQUIRE_FALSE(child_executed);
+    REQUIRE(thread_pool.missed_count() == 1);
+    REQUIRE(thread_pool.shed_count() == 1);
+
+    const auto missed_deadline = cf::deadline_clock_t::now() - 1ms;
+    REQUIRE_THROWS_AS(cf::sync_wait(child(), &thread_pool, missed_deadline),
+                      cf::deadline_exceeded_error);
+    REQUIRE(thread_pool.shed_count() == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Only the late coroutine is shed, not the ones it waits for",
+                 "[deadline]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::edf_thread_pool_t thread_pool(
+        1,
+        cf::deadline_miss_policy_t::shed);
+    auto child = []() -> cf::task<int> { co_return 1; };
+
+    // The late callback doesn't start a coroutine, the child is started by
+    // the same worker while the callback waits for it.
+    std::promise<int> result;
+    cf::schedule_hints_t hints;
+    hints.deadline = cf::deadline_clock_t::now() - 1ms;
+    cf::tag_invoke(
+        cf::schedule_task_t{},
+        &thread_pool,
+        [&]
+        {
+          try
+          {
+            result.set_value(cf::sync_wait(child(), &thread_pool));
+          }
+          catch (...)
+          {
+            result.set_exception(std::current_exception());
+          }
+        },
+        hints);
+
+    auto future = result.get_future();
+    REQUIRE(future.wait_for(c_test_case_timeout) == std::future_status::ready);
+    REQUIRE(future.get() == 1);
+    REQUIRE(thread_pool.missed_count() == 1);
+    REQUIRE(thread_pool.shed_count() == 0);
+  }
+  memory_checker.check();
+}
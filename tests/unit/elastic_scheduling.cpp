@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+template <typename predicate_t>
+bool wait_until(predicate_t&& predicate)
+{
+  const auto timeout = std::chrono::steady_clock::now() + c_test_case_timeout;
+  while (predicate() == false)
+  {
+    if (std::chrono::steady_clock::now() > timeout)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Elastic pool starts without workers",
+                 "[elastic]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 0, .max_threads = 2 });
+    REQUIRE(thread_pool.metrics().thread_count == 0);
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int> { co_return co_await coro_1() + 1; };
+
+    REQUIRE(cf::sync_wait(coro_2(), &thread_pool) == 2);
+    REQUIRE(thread_pool.metrics().spawned >= 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Elastic pool grows with the load up to the maximum",
+                 "[elastic]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 4 });
+    REQUIRE(thread_pool.metrics().thread_count == 1);
+
+    std::promise<void> release_workers;
+    std::shared_future<void> released = release_workers.get_future().share();
+    std::atomic_int finished_count{ 0 };
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    auto blocker = [&]() -> cf::task<int>
+    {
+      released.wait();
+      if (++finished_count == 5)
+      {
+        finished_event.trigger();
+      }
+      co_return 0;
+    };
+    for (int i = 0; i < 5; ++i)
+    {
+      cf::run_async(blocker(), &thread_pool);
+    }
+
+    // Every worker is blocked, the 5th task has to wait
+    const auto metrics = thread_pool.metrics();
+    REQUIRE(metrics.thread_count == 4);
+    REQUIRE(metrics.peak_thread_count == 4);
+    REQUIRE(metrics.spawned == 4);
+    REQUIRE(metrics.retired == 0);
+
+    release_workers.set_value();
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Idle workers are retired down to the minimum",
+                 "[elastic]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 3, .idle_timeout = 20ms });
+
+    std::promise<void> release_workers;
+    std::shared_future<void> released = release_workers.get_future().share();
+    auto blocker = [&]() -> cf::task<int>
+    {
+      released.wait();
+      co_return 0;
+    };
+    for (int i = 0; i < 3; ++i)
+    {
+      cf::run_async(blocker(), &thread_pool);
+    }
+    REQUIRE(thread_pool.metrics().thread_count == 3);
+    release_workers.set_value();
+
+    REQUIRE(wait_until([&] { return thread_pool.metrics().retired == 2; }));
+    const auto metrics = thread_pool.metrics();
+    REQUIRE(metrics.thread_count == 1);
+    REQUIRE(metrics.peak_thread_count == 3);
+
+    // The pool is still usable after shrinking
+    auto coro = []() -> cf::task<int> { co_return 1; };
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Waiting tasks spawn a worker while every worker is busy",
+                 "[elastic]")
+{
+  memory_check_t memory_checker;
+  {
+    // The queue never gets deep, only the waiting time can spawn
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1,
+          .max_threads = 2,
+          .spawn_queue_depth = 100,
+          .spawn_latency = 5ms });
+
+    auto [release_event, release_token] = event_t::create("release");
+    auto blocker = [&]() -> cf::task<int>
+    {
+      REQUIRE(release_token.is_triggered(c_test_case_timeout));
+      co_return 0;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      release_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(blocker(), &thread_pool);
+    // Nothing is pushed or dequeued until the blocker is released
+    cf::run_async(releaser(), &thread_pool);
+
+    REQUIRE(wait_until([&] { return thread_pool.metrics().spawned == 2; }));
+    REQUIRE(release_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Destroyed elastic pool drains its queue",
+                 "[elastic]")
+{
+  memory_check_t memory_checker;
+  {
+    constexpr int c_task_count = 8;
+    std::atomic_int executed{ 0 };
+    std::promise<void> release_worker;
+    {
+      cf::schedulers::elastic_thread_pool_t thread_pool(
+          { .min_threads = 1, .max_threads = 1 });
+      auto blocker = [](std::shared_future<void> released) -> cf::task<int>
+      {
+        released.wait();
+        co_return 0;
+      };
+      auto coro = [&]() -> cf::task<int>
+      {
+        ++executed;
+        co_return 1;
+      };
+      cf::run_async(blocker(release_worker.get_future().share()),
+                    &thread_pool);
+      // Queued behind the blocker of the only worker
+      for (int i = 0; i < c_task_count; ++i)
+      {
+        cf::run_async(coro(), &thread_pool);
+      }
+      release_worker.set_value();
+    }
+    REQUIRE(executed == c_task_count);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/recording_scheduler.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/fair_share_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::recording_scheduler_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+constexpr const cf::group_id_t c_tenant_a{ 1 };
+constexpr const cf::group_id_t c_tenant_b{ 2 };
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Group is inherited by the awaited coroutines",
+                 "[fair_share]")
+{
+  memory_check_t memory_checker;
+  {
+    recording_scheduler_t scheduler;
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int> { co_return co_await coro_1(); };
+
+    REQUIRE(cf::sync_wait(coro_2(), &scheduler, c_tenant_b) == 1);
+    REQUIRE(scheduler.scheduled_with ==
+            std::vector<cf::schedule_hints_t>{ c_tenant_b, c_tenant_b });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Flooding group can't starve the others",
+                 "[fair_share]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::fair_share_thread_pool_t thread_pool(1, 1ms);
+
+    std::promise<void> release_worker;
+    auto blocker = [](std::shared_future<void> released) -> cf::task<int>
+    {
+      released.wait();
+      co_return 0;
+    };
+    cf::run_async(blocker(release_worker.get_future().share()), &thread_pool);
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    // Every task is more expensive than the quantum, so the groups alternate
+    auto record = [&](std::string id) -> cf::task<int>
+    {
+      std::this_thread::sleep_for(2ms);
+      std::lock_guard lock(order_mutex);
+      order.push_back(id);
+      if (order.size() == 6)
+      {
+        finished_event.trigger();
+      }
+      co_return 0;
+    };
+    cf::run_async(record("a1"), &thread_pool, c_tenant_a);
+    cf::run_async(record("a2"), &thread_pool, c_tenant_a);
+    cf::run_async(record("a3"), &thread_pool, c_tenant_a);
+    cf::run_async(record("a4"), &thread_pool, c_tenant_a);
+    cf::run_async(record("b1"), &thread_pool, c_tenant_b);
+    cf::run_async(record("b2"), &thread_pool, c_tenant_b);
+
+    REQUIRE(thread_pool.statistics(c_tenant_a).queue_depth == 4);
+    REQUIRE(thread_pool.statistics(c_tenant_b).queue_depth == 2);
+
+    release_worker.set_value();
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    {
+      std::lock_guard lock(order_mutex);
+      REQUIRE(order == std::vector<std::string>{
+                           "a1", "b1", "a2", "b2", "a3", "a4" });
+    }
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Execution time is accounted per group",
+                 "[fair_share]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::fair_share_thread_pool_t thread_pool(2);
+    auto coro = []() -> cf::task<int>
+    {
+      std::this_thread::sleep_for(5ms);
+      co_return 1;
+    };
+    auto parent = [&]() -> cf::task<int>
+    {
+      int result = co_await coro();
+      result += co_await coro();
+      co_return result;
+    };
+
+    REQUIRE(cf::sync_wait(parent(), &thread_pool, c_tenant_a) == 2);
+
+    // The accounting of the last callback can be still in progress when
+    // sync_wait returns.
+    const auto statistics = thread_pool.statistics(c_tenant_a);
+    REQUIRE(statistics.queue_depth == 0);
+    REQUIRE(statistics.executed >= 2);
+    REQUIRE(statistics.busy_time >= 5ms);
+    REQUIRE(thread_pool.statistics(c_tenant_b).executed == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE("Dequeued tasks are charged before they are executed",
+          "[fair_share]")
+{
+  cf::__details::fair_share_queue_t queue(1ms);
+  const auto now = cf::__details::worker_clock_t::now();
+  std::vector<cf::group_id_t> order;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    queue.push([&] { order.push_back(c_tenant_a); }, c_tenant_a, now);
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    queue.push([&] { order.push_back(c_tenant_b); }, c_tenant_b, now);
+  }
+  // Like busy workers: nothing is executed until every task is dequeued
+  std::vector<std::function<void()>> dequeued;
+  while (queue.empty() == false)
+  {
+    dequeued.push_back(*queue.pop(now));
+  }
+  for (auto& callback : dequeued)
+  {
+    callback();
+  }
+
+  REQUIRE(order == std::vector<cf::group_id_t>{ c_tenant_a,
+                                                c_tenant_b,
+                                                c_tenant_a,
+                                                c_tenant_b,
+                                                c_tenant_a,
+                                                c_tenant_b,
+                                                c_tenant_a,
+                                                c_tenant_b });
+  const cf::group_statistics_t statistics = queue.statistics(c_tenant_a);
+  REQUIRE(statistics.executed == 4);
+  REQUIRE(statistics.queue_depth == 0);
+}
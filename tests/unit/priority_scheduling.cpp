@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/recording_scheduler.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::recording_scheduler_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Priority is inherited by the awaited coroutines",
+                 "[priority]")
+{
+  memory_check_t memory_checker;
+  {
+    recording_scheduler_t scheduler;
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      int result = co_await coro_1();
+      result += co_await coro_1();
+      co_return result;
+    };
+
+    const int result =
+        cf::sync_wait(coro_2(), &scheduler, cf::priority_t::high);
+
+    REQUIRE(result == 2);
+    REQUIRE(scheduler.scheduled_with.size() == 3);
+    for (const auto& hints : scheduler.scheduled_with)
+    {
+      REQUIRE(hints.priority == cf::priority_t::high);
+    }
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Default priority is normal",
+                 "[priority]")
+{
+  memory_check_t memory_checker;
+  {
+    recording_scheduler_t scheduler;
+    auto coro = []() -> cf::task<int> { co_return 1; };
+
+    REQUIRE(cf::sync_wait(coro(), &scheduler) == 1);
+    REQUIRE(scheduler.scheduled_with.size() == 1);
+    REQUIRE(scheduler.scheduled_with[0].priority == cf::priority_t::normal);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "High priority tasks overtake low priority ones",
+                 "[priority]")
+{
+  memory_check_t memory_checker;
+  {
+    // Aging is practically turned off to have a deterministic order
+    cf::schedulers::priority_thread_pool_t thread_pool(1, 1h);
+
+    std::promise<void> release_worker;
+    auto blocker = [](std::shared_future<void> released) -> cf::task<int>
+    {
+      released.wait();
+      co_return 0;
+    };
+    cf::run_async(blocker(release_worker.get_future().share()), &thread_pool);
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    auto record = [&](int id) -> cf::task<int>
+    {
+      std::lock_guard lock(order_mutex);
+      order.push_back(id);
+      if (order.size() == 4)
+      {
+        finished_event.trigger();
+      }
+      co_return id;
+    };
+
+    cf::run_async(record(1), &thread_pool, cf::priority_t::low);
+    cf::run_async(record(2), &thread_pool, cf::priority_t::high);
+    cf::run_async(record(3), &thread_pool, cf::priority_t::low);
+    cf::run_async(record(4), &thread_pool, cf::priority_t::critical);
+    REQUIRE(thread_pool.queue_size(cf::priority_t::low) == 2);
+
+    release_worker.set_value();
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    std::lock_guard lock(order_mutex);
+    REQUIRE(order == std::vector<int>{ 4, 2, 1, 3 });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE("Aged low priority entries overtake fresh high priority ones",
+          "[priority]")
+{
+  cf::__details::priority_queue_t queue(10ms);
+  const auto start = cf::__details::worker_clock_t::now();
+  std::vector<int> order;
+
+  queue.push([&] { order.push_back(1); }, cf::priority_t::low, start);
+  queue.push([&] { order.push_back(2); },
+             cf::priority_t::critical,
+             start + 30ms);
+  queue.push([&] { order.push_back(3); },
+             cf::priority_t::critical,
+             start + 30ms);
+
+  // low waited 3 steps: 0 + 3 equals to critical, but it is older.
+  (*queue.pop(start + 30ms))();
+  // The new low entry aged only one level, the critical ones go first
+  queue.push([&] { order.push_back(4); }, cf::priority_t::low, start + 30ms);
+  (*queue.pop(start + 45ms))();
+  (*queue.pop(start + 45ms))();
+  (*queue.pop(start + 45ms))();
+  REQUIRE(queue.empty());
+  REQUIRE_FALSE(queue.pop(start + 45ms).has_value());
+
+  REQUIRE(order == std::vector<int>{ 1, 2, 3, 4 });
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Destroyed priority pool drains its queue",
+                 "[priority]")
+{
+  memory_check_t memory_checker;
+  {
+    constexpr int c_task_count = 8;
+    std::atomic_int executed{ 0 };
+    std::promise<void> release_worker;
+    {
+      cf::schedulers::priority_thread_pool_t thread_pool(1);
+      auto blocker = [](std::shared_future<void> released) -> cf::task<int>
+      {
+        released.wait();
+        co_return 0;
+      };
+      auto coro = [&]() -> cf::task<int>
+      {
+        ++executed;
+        co_return 1;
+      };
+      cf::run_async(blocker(release_worker.get_future().share()),
+                    &thread_pool);
+      // Queued behind the blocker of the only worker
+      for (int i = 0; i < c_task_count; ++i)
+      {
+        cf::run_async(coro(), &thread_pool);
+      }
+      release_worker.set_value();
+    }
+    REQUIRE(executed == c_task_count);
+  }
+  memory_checker.check();
+}
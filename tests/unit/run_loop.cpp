@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+
+#include <coroutine_flow/blocking.hpp>
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/schedulers/run_loop.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::memory_check_t;
+
+namespace
+{
+// The helping thread only waits for the result, it can't poll
+struct waiting_pool_t
+{
+    cf::schedulers::priority_thread_pool_t pool{ 1 };
+    std::atomic_int help_count{ 0 };
+};
+void tag_invoke(cf::schedule_task_t,
+                waiting_pool_t* scheduler,
+                std::function<void()> callback,
+                const cf::schedule_hints_t& hints)
+{
+  cf::tag_invoke(cf::schedule_task_t{},
+                 &scheduler->pool,
+                 std::move(callback),
+                 hints);
+}
+bool tag_invoke(cf::run_pending_task_t,
+                waiting_pool_t* scheduler,
+                std::stop_token ready)
+{
+  ++scheduler->help_count;
+  std::mutex mutex;
+  std::condition_variable_any condition;
+  std::unique_lock lock(mutex);
+  condition.wait(lock, ready, [] { return false; });
+  return true;
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sync wait executes the coroutine on the calling thread",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic_int foreign_thread_count{ 0 };
+    auto check_thread = [&]
+    {
+      if (std::this_thread::get_id() != caller)
+      {
+        ++foreign_thread_count;
+      }
+    };
+    auto coro_1 = [&](int value) -> cf::task<int>
+    {
+      check_thread();
+      co_return value;
+    };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      check_thread();
+      int result = co_await coro_1(1);
+      // Continued on the caller again
+      result += co_await cf::blocking([] { return 2; });
+      check_thread();
+      result += co_await coro_1(3);
+      check_thread();
+      co_return result;
+    };
+
+    REQUIRE(cf::sync_wait(coro_2()) == 6);
+    REQUIRE(foreign_thread_count == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Run loop executes the tasks until it is finished",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::run_loop loop;
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic_int executed_on_caller{ 0 };
+    std::atomic_int finished_count{ 0 };
+    constexpr int c_task_count = 10;
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      const int result = co_await coro_1();
+      if (std::this_thread::get_id() == caller)
+      {
+        ++executed_on_caller;
+      }
+      if (++finished_count == c_task_count)
+      {
+        loop.finish();
+      }
+      co_return result;
+    };
+    std::jthread producer(
+        [&]
+        {
+          for (int i = 0; i < c_task_count; ++i)
+          {
+            cf::run_async(coro_2(), &loop);
+          }
+        });
+    loop.run();
+
+    REQUIRE(finished_count == c_task_count);
+    REQUIRE(executed_on_caller == c_task_count);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sync wait on a worker helps its pool",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    // With one worker blocking sync_wait would be a deadlock
+    cf::schedulers::priority_thread_pool_t thread_pool(1);
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      const int result = co_await coro_1();
+      co_return result + cf::sync_wait(coro_1(), &thread_pool);
+    };
+
+    REQUIRE(cf::sync_wait(coro_2(), &thread_pool) == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sync wait on a worker helps its elastic pool",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      const int result = co_await coro_1();
+      co_return result + cf::sync_wait(coro_1(), &thread_pool);
+    };
+
+    REQUIRE(cf::sync_wait(coro_2(), &thread_pool) == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sync wait is woken when the result is set",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    waiting_pool_t scheduler;
+
+    auto coro = []() -> cf::task<int>
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+      co_return 1;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &scheduler) == 1);
+    // No timeout, the waiting thread was woken once by the result
+    REQUIRE(scheduler.help_count == 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Destroyed loop executes the queued tasks",
+                 "[run_loop]")
+{
+  memory_check_t memory_checker;
+  {
+    std::atomic_int executed{ 0 };
+    {
+      cf::schedulers::run_loop_t loop;
+
+      auto child = [&]() -> cf::task<int>
+      {
+        ++executed;
+        co_return 1;
+      };
+      auto coro = [&]() -> cf::task<int>
+      {
+        ++executed;
+        co_return co_await child();
+      };
+      cf::run_async(coro(), &loop);
+    }
+    // The child was queued by the drain itself
+    REQUIRE(executed == 2);
+  }
+  memory_checker.check();
+}
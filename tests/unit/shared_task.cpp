@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/shared_task.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Concurrent awaiters share one computation",
+                 "[shared_task]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    auto [release_event, release_token] = event_t::create("release");
+    std::atomic_int computations{ 0 };
+
+    auto compute = [&]() -> cf::task<std::string>
+    {
+      ++computations;
+      REQUIRE(release_token.is_triggered(c_test_case_timeout));
+      co_return "expensive";
+    };
+    cf::shared_task<std::string> shared(compute());
+    auto awaiter = [&]() -> cf::task<const std::string*>
+    {
+      const std::string& value = co_await shared;
+      co_return &value;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      std::vector<cf::task<const std::string*>> awaiters;
+      for (int i = 0; i < 8; ++i)
+      {
+        awaiters.push_back(awaiter());
+      }
+      release_event.trigger();
+      const std::vector<const std::string*> results =
+          co_await cf::when_all(std::move(awaiters));
+      for (const std::string* result : results)
+      {
+        REQUIRE(result == results.front());
+      }
+      co_return *results.front() == "expensive";
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(computations == 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Awaiter of a finished computation doesn't suspend",
+                 "[shared_task]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int computations{ 0 };
+
+    auto compute = [&]() -> cf::task<int>
+    {
+      ++computations;
+      co_return 42;
+    };
+    cf::shared_task<int> shared(compute());
+    // Nothing is computed before the first co_await
+    REQUIRE(shared.is_ready() == false);
+    REQUIRE(computations == 0);
+
+    auto coro = [&]() -> cf::task<int> { co_return co_await shared; };
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 42);
+    REQUIRE(shared.is_ready());
+    // A copy refers to the same result
+    cf::shared_task<int> copy = shared;
+    REQUIRE(copy.await_ready());
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 42);
+    REQUIRE(computations == 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Exception is rethrown to every awaiter",
+                 "[shared_task]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto compute = []() -> cf::task<int>
+    {
+      throw test_exception_t{};
+      co_return 0;
+    };
+    cf::shared_task<int> shared(compute());
+    auto coro = [&]() -> cf::task<int> { co_return co_await shared; };
+
+    REQUIRE_THROWS_AS(cf::sync_wait(coro(), &thread_pool), test_exception_t);
+    REQUIRE_THROWS_AS(cf::sync_wait(coro(), &thread_pool), test_exception_t);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/schedulers/run_loop.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Executes everything inline, its timers expire immediately
+struct fake_timer_scheduler_t
+{
+    std::vector<cf::timer_clock_t::duration>* requested_delays;
+};
+
+void tag_invoke(cf::schedule_task_t,
+                fake_timer_scheduler_t,
+                std::function<void()> callback)
+{
+  callback();
+}
+void tag_invoke(cf::schedule_after_t,
+                fake_timer_scheduler_t scheduler,
+                std::function<void()> callback,
+                cf::timer_clock_t::duration delay,
+                const cf::schedule_hints_t&)
+{
+  scheduler.requested_delays->push_back(delay);
+  callback();
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sleep continues on the scheduler of the coroutine",
+                 "[sleep]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    auto coro = []() -> cf::task<std::vector<std::thread::id>>
+    {
+      std::vector<std::thread::id> threads;
+      threads.push_back(std::this_thread::get_id());
+      co_await cf::sleep_for(20ms);
+      threads.push_back(std::this_thread::get_id());
+      co_return threads;
+    };
+
+    const auto start = cf::timer_clock_t::now();
+    const auto threads = cf::sync_wait(coro(), &thread_pool);
+    REQUIRE(cf::timer_clock_t::now() - start >= 20ms);
+    // The timer thread of the library only hands over the continuation
+    REQUIRE(threads.size() == 2);
+    REQUIRE(threads[0] == threads[1]);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sleep uses the timers of the scheduler",
+                 "[sleep]")
+{
+  memory_check_t memory_checker;
+  {
+    std::vector<cf::timer_clock_t::duration> requested_delays;
+    auto coro = []() -> cf::task<int>
+    {
+      co_await cf::sleep_for(1h);
+      // Already expired, it doesn't suspend
+      co_await cf::sleep_until(cf::timer_clock_t::now() - 1s);
+      co_return 1;
+    };
+
+    REQUIRE(cf::sync_wait(coro(),
+                          fake_timer_scheduler_t{ &requested_delays }) == 1);
+    REQUIRE(requested_delays.size() == 1);
+    REQUIRE(requested_delays[0] > 59min);
+    REQUIRE(requested_delays[0] <= 1h);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Run loop waits for its own timers",
+                 "[sleep]")
+{
+  static_assert(cf::schedule_at_scheduler<cf::run_loop*>);
+  memory_check_t memory_checker;
+  {
+    const std::thread::id caller = std::this_thread::get_id();
+    auto coro = [&]() -> cf::task<bool>
+    {
+      co_await cf::sleep_for(10ms);
+      const bool first_on_caller = std::this_thread::get_id() == caller;
+      co_await cf::sleep_for(10ms);
+      co_return first_on_caller && std::this_thread::get_id() == caller;
+    };
+
+    const auto start = cf::timer_clock_t::now();
+    REQUIRE(cf::sync_wait(coro()));
+    REQUIRE(cf::timer_clock_t::now() - start >= 20ms);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,269 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/strand.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+// Detects if two tasks are executed at the same time
+struct concurrency_detector_t
+{
+    std::atomic_int inside{ 0 };
+    std::atomic_bool overlapped{ false };
+
+    void enter()
+    {
+      if (inside.fetch_add(1) != 0)
+      {
+        overlapped = true;
+      }
+    }
+    void leave() { inside.fetch_sub(1); }
+};
+
+// Keeps the scheduled callbacks, the test executes them one by one
+struct manual_scheduler_t
+{
+    std::deque<std::function<void()>> callbacks;
+
+    void run_one()
+    {
+      std::function<void()> callback = std::move(callbacks.front());
+      callbacks.pop_front();
+      callback();
+    }
+};
+
+void tag_invoke(cf::schedule_task_t,
+                manual_scheduler_t* scheduler,
+                std::function<void()> callback)
+{
+  scheduler->callbacks.push_back(std::move(callback));
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Tasks of a strand are not executed concurrently",
+                 "[strand]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::strand<cf::schedulers::priority_thread_pool_t*> strand(&thread_pool);
+
+    constexpr int c_task_count = 200;
+    concurrency_detector_t detector;
+    int counter = 0;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    auto coro = [&]() -> cf::task<int>
+    {
+      detector.enter();
+      std::this_thread::yield();
+      const int value = ++counter;
+      detector.leave();
+      if (value == c_task_count)
+      {
+        finished_event.trigger();
+      }
+      co_return value;
+    };
+    for (int i = 0; i < c_task_count; ++i)
+    {
+      cf::run_async(coro(), strand);
+    }
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(detector.overlapped == false);
+    REQUIRE(counter == c_task_count);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Strand executes the tasks in submission order",
+                 "[strand]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::strand<cf::schedulers::priority_thread_pool_t*> strand(&thread_pool);
+
+    constexpr int c_task_count = 500;
+    std::vector<int> order;
+    auto [finished_event, finished_token] = event_t::create("all finished");
+    for (int i = 0; i < c_task_count; ++i)
+    {
+      cf::tag_invoke(cf::schedule_task_t{},
+                     strand,
+                     [&, i]
+                     {
+                       order.push_back(i);
+                       if (i == c_task_count - 1)
+                       {
+                         finished_event.trigger();
+                       }
+                     },
+                     cf::schedule_hints_t{});
+    }
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(order.size() == c_task_count);
+    for (int i = 0; i < c_task_count; ++i)
+    {
+      REQUIRE(order[i] == i);
+    }
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Coroutine enters the strand in the middle of its body",
+                 "[strand]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::strand<cf::schedulers::priority_thread_pool_t*> strand(&thread_pool);
+
+    constexpr int c_task_count = 100;
+    concurrency_detector_t detector;
+    int counter = 0;
+    auto coro_1 = []() -> cf::task<int> { co_return 1; };
+    auto coro_2 = [&]() -> cf::task<int>
+    {
+      // Executed concurrently on the pool
+      int increment = co_await coro_1();
+
+      co_await strand.enter();
+      detector.enter();
+      std::this_thread::yield();
+      counter += increment;
+      detector.leave();
+      co_return increment;
+    };
+    auto coro_3 = [&]() -> cf::task<int>
+    {
+      int result = 0;
+      for (int i = 0; i < c_task_count; ++i)
+      {
+        result += co_await coro_2();
+      }
+      co_return result;
+    };
+    std::vector<std::jthread> callers;
+    std::atomic_int sum{ 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+      callers.emplace_back([&]
+                           { sum += cf::sync_wait(coro_3(), &thread_pool); });
+    }
+    callers.clear();
+
+    REQUIRE(sum == 4 * c_task_count);
+    REQUIRE(counter == 4 * c_task_count);
+    REQUIRE(detector.overlapped == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Nested coroutines that start by entering the strand contend",
+                 "[strand]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::strand<cf::schedulers::priority_thread_pool_t*> strand(&thread_pool);
+
+    constexpr int c_task_count = 200;
+    concurrency_detector_t detector;
+    int counter = 0;
+    auto child = [&]() -> cf::task<int>
+    {
+      // The first slice of the child hops onto the strand
+      co_await strand.enter();
+      detector.enter();
+      std::this_thread::yield();
+      ++counter;
+      detector.leave();
+      co_return 1;
+    };
+    auto parent = [&]() -> cf::task<int>
+    {
+      int result = 0;
+      for (int i = 0; i < c_task_count; ++i)
+      {
+        result += co_await child();
+      }
+      co_return result;
+    };
+    std::vector<std::jthread> callers;
+    std::atomic_int sum{ 0 };
+    for (int i = 0; i < 4; ++i)
+    {
+      callers.emplace_back([&]
+                           { sum += cf::sync_wait(parent(), &thread_pool); });
+    }
+    callers.clear();
+
+    REQUIRE(sum == 4 * c_task_count);
+    REQUIRE(counter == 4 * c_task_count);
+    REQUIRE(detector.overlapped == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Strand continues after a throwing task",
+                 "[strand]")
+{
+  memory_check_t memory_checker;
+  {
+    manual_scheduler_t scheduler;
+    cf::strand<manual_scheduler_t*> strand(&scheduler);
+    int executed = 0;
+
+    const cf::schedule_hints_t hints;
+    cf::__details::schedule_task(
+        strand, [] { throw std::runtime_error("failed"); }, hints);
+    cf::__details::schedule_task(strand, [&] { ++executed; }, hints);
+    REQUIRE(scheduler.callbacks.size() == 1);
+    REQUIRE_THROWS_AS(scheduler.run_one(), std::runtime_error);
+
+    // The rest of the strand is drained by a rescheduled batch
+    REQUIRE(scheduler.callbacks.size() == 1);
+    scheduler.run_one();
+    REQUIRE(executed == 1);
+    REQUIRE(scheduler.callbacks.empty());
+
+    // The strand is empty again, new work schedules a drain
+    cf::__details::schedule_task(strand, [&] { ++executed; }, hints);
+    REQUIRE(scheduler.callbacks.size() == 1);
+    scheduler.run_one();
+    REQUIRE(executed == 2);
+  }
+  memory_checker.check();
+}
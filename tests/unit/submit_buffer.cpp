@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/async_scope.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+struct counting_pool_t
+{
+    explicit counting_pool_t(std::size_t thread_count)
+        : pool(thread_count)
+    {
+    }
+    cf::schedulers::priority_thread_pool_t pool;
+    std::atomic_int single_count{ 0 };
+    std::atomic_int bulk_count{ 0 };
+    std::atomic_int bulk_task_count{ 0 };
+};
+
+void tag_invoke(cf::schedule_task_t,
+                counting_pool_t* scheduler,
+                std::function<void()> callback,
+                const cf::schedule_hints_t& hints)
+{
+  ++scheduler->single_count;
+  cf::tag_invoke(cf::schedule_task_t{},
+                 &scheduler->pool,
+                 std::move(callback),
+                 hints);
+}
+void tag_invoke(cf::schedule_bulk_t,
+                counting_pool_t* scheduler,
+                std::vector<std::function<void()>> callbacks,
+                const cf::schedule_hints_t& hints)
+{
+  ++scheduler->bulk_count;
+  scheduler->bulk_task_count += static_cast<int>(callbacks.size());
+  cf::tag_invoke(cf::schedule_bulk_t{},
+                 &scheduler->pool,
+                 std::move(callbacks),
+                 hints);
+}
+bool tag_invoke(cf::run_pending_task_t,
+                counting_pool_t* scheduler,
+                std::stop_token ready)
+{
+  return cf::tag_invoke(cf::run_pending_task_t{},
+                        &scheduler->pool,
+                        std::move(ready));
+}
+
+// Refuses every batch, e.g. a pool that can't grow its queue
+struct refusing_scheduler_t
+{
+};
+
+void tag_invoke(cf::schedule_task_t,
+                refusing_scheduler_t*,
+                std::function<void()> callback)
+{
+  callback();
+}
+void tag_invoke(cf::schedule_bulk_t,
+                refusing_scheduler_t*,
+                std::vector<std::function<void()>>,
+                const cf::schedule_hints_t&)
+{
+  throw std::runtime_error("refused");
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Tasks spawned during a resume are submitted together",
+                 "[submit_buffer]")
+{
+  memory_check_t memory_checker;
+  {
+    counting_pool_t scheduler(2);
+    constexpr int c_child_count = 8;
+    std::atomic_int finished_count{ 0 };
+    auto [finished_event, finished_token] = event_t::create("all finished");
+
+    auto child = [&]() -> cf::task<int>
+    {
+      if (++finished_count == c_child_count)
+      {
+        finished_event.trigger();
+      }
+      co_return 1;
+    };
+    auto parent = [&]() -> cf::task<int>
+    {
+      for (int i = 0; i < c_child_count; ++i)
+      {
+        cf::run_async(child(), &scheduler);
+      }
+      co_return 0;
+    };
+    cf::run_async(parent(), &scheduler);
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    // Only the parent is scheduled directly
+    REQUIRE(scheduler.single_count == 1);
+    REQUIRE(scheduler.bulk_count == 1);
+    REQUIRE(scheduler.bulk_task_count == c_child_count);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Sync wait in a coroutine submits the buffered tasks",
+                 "[submit_buffer]")
+{
+  memory_check_t memory_checker;
+  {
+    counting_pool_t scheduler(1);
+
+    auto child = []() -> cf::task<int> { co_return 1; };
+    auto parent = [&]() -> cf::task<int>
+    {
+      const int result = co_await child();
+      // The only worker helps the pool until the nested task is finished
+      co_return result + cf::sync_wait(child(), &scheduler);
+    };
+
+    REQUIRE(cf::sync_wait(parent(), &scheduler) == 2);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Blocking join in a coroutine submits the buffered tasks",
+                 "[submit_buffer]")
+{
+  memory_check_t memory_checker;
+  {
+    counting_pool_t scheduler(2);
+    cf::async_scope scope;
+    std::atomic_bool child_finished{ false };
+
+    auto child = [&]() -> cf::task<int>
+    {
+      child_finished = true;
+      co_return 1;
+    };
+    auto parent = [&]() -> cf::task<bool>
+    {
+      scope.spawn(child(), &scheduler);
+      // The other worker executes the child
+      scope.join_sync();
+      co_return child_finished.load();
+    };
+
+    REQUIRE(cf::sync_wait(parent(), &scheduler));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Refused batch is rethrown by the end of the scope",
+                 "[submit_buffer]")
+{
+  using submit_buffer_t = cf::__details::submit_buffer_t;
+  refusing_scheduler_t scheduler;
+  const cf::schedule_hints_t hints;
+  {
+    submit_buffer_t::scope_t scope;
+    std::function<void()> callback = [] {};
+    REQUIRE(submit_buffer_t::instance().try_push(&scheduler, callback, hints));
+    REQUIRE_THROWS_AS(scope.end(), std::runtime_error);
+  }
+  // While an exception propagates, the refusal can't replace it
+  auto fail_in_scope = [&]
+  {
+    submit_buffer_t::scope_t scope;
+    std::function<void()> callback = [] {};
+    submit_buffer_t::instance().try_push(&scheduler, callback, hints);
+    throw std::logic_error("failed");
+  };
+  REQUIRE_THROWS_AS(fail_in_scope(), std::logic_error);
+  // Nothing is left in the buffer of the thread
+  std::function<void()> callback = [] {};
+  REQUIRE(submit_buffer_t::instance().try_push(&scheduler, callback, hints) ==
+          false);
+}
@@ -0,0 +1,436 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/async_barrier.hpp>
+#include <coroutine_flow/async_condition_variable.hpp>
+#include <coroutine_flow/async_event.hpp>
+#include <coroutine_flow/async_latch.hpp>
+#include <coroutine_flow/async_mutex.hpp>
+#include <coroutine_flow/async_semaphore.hpp>
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Semaphore bounds the concurrency",
+                 "[async_semaphore]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::async_semaphore semaphore(2);
+    std::atomic_int running{ 0 };
+    std::atomic_int max_running{ 0 };
+
+    auto request = [&]() -> cf::task<int>
+    {
+      co_await semaphore.acquire();
+      const int current = ++running;
+      int expected = max_running;
+      while (expected < current &&
+             max_running.compare_exchange_weak(expected, current) == false)
+      {
+      }
+      co_await cf::sleep_for(1ms);
+      --running;
+      semaphore.release();
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> requests;
+      for (int i = 0; i < 10; ++i)
+      {
+        requests.push_back(request());
+      }
+      co_await cf::when_all(std::move(requests));
+      co_return max_running.load();
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 2);
+    REQUIRE(semaphore.available() == 2);
+    REQUIRE(semaphore.try_acquire());
+    REQUIRE(semaphore.try_acquire());
+    REQUIRE(semaphore.try_acquire() == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Batch release continues several waiters and the latch",
+                 "[async_semaphore][async_latch]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_semaphore semaphore(0);
+    cf::async_latch started(3);
+    cf::async_latch finished(3);
+    std::atomic_int acquired{ 0 };
+
+    auto waiter = [&]() -> cf::task<int>
+    {
+      started.count_down();
+      co_await semaphore.acquire();
+      ++acquired;
+      finished.count_down();
+      co_return 0;
+    };
+    auto releaser = [&]() -> cf::task<int>
+    {
+      co_await started.wait();
+      // Two of them are continued, the third one waits for one more
+      semaphore.release(2);
+      co_await cf::sleep_for(10ms);
+      const int acquired_before = acquired;
+      semaphore.release();
+      co_await finished.wait();
+      co_return acquired_before;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      auto [first, second, third, acquired_before] =
+          co_await cf::when_all(waiter(), waiter(), waiter(), releaser());
+      co_return acquired_before;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 2);
+    REQUIRE(acquired == 3);
+    REQUIRE(finished.try_wait());
+    REQUIRE(semaphore.available() == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Barrier separates the phases",
+                 "[async_barrier]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    constexpr int c_workers = 4;
+    constexpr int c_phases = 5;
+    cf::async_barrier barrier(c_workers);
+    std::atomic_int finished_steps{ 0 };
+
+    auto worker = [&](int id) -> cf::task<bool>
+    {
+      bool in_order = true;
+      for (int phase = 0; phase < c_phases; ++phase)
+      {
+        // Every worker of the previous phases has finished
+        in_order = in_order && finished_steps >= phase * c_workers;
+        if (id == phase % c_workers)
+        {
+          co_await cf::sleep_for(1ms);
+        }
+        ++finished_steps;
+        co_await barrier.arrive_and_wait();
+      }
+      co_return in_order;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto results =
+          co_await cf::when_all(worker(0), worker(1), worker(2), worker(3));
+      co_return std::apply([](auto... result) { return (result && ...); },
+                           results);
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(barrier.phase() == c_phases);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Manual reset event continues every waiter",
+                 "[async_event]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_event event;
+    std::atomic_int continued{ 0 };
+
+    auto waiter = [&]() -> cf::task<int>
+    {
+      co_await event.wait();
+      ++continued;
+      co_return 1;
+    };
+    auto setter = [&]() -> cf::task<int>
+    {
+      co_await cf::sleep_for(10ms);
+      const int continued_before = continued;
+      event.set();
+      co_return continued_before;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> tasks;
+      for (int i = 0; i < 8; ++i)
+      {
+        tasks.push_back(waiter());
+      }
+      tasks.push_back(setter());
+      auto results = co_await cf::when_all(std::move(tasks));
+      // Set events don't suspend
+      co_await event.wait();
+      co_return results.back();
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 0);
+    REQUIRE(continued == 8);
+    REQUIRE(event.is_set());
+    event.reset();
+    REQUIRE(event.is_set() == false);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Automatic reset event continues one waiter per set",
+                 "[async_event]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_event event(false, cf::async_event_reset::automatic);
+    cf::async_latch started(3);
+    std::atomic_int continued{ 0 };
+
+    auto waiter = [&]() -> cf::task<int>
+    {
+      started.count_down();
+      co_await event.wait();
+      ++continued;
+      co_return 0;
+    };
+    auto setter = [&]() -> cf::task<bool>
+    {
+      co_await started.wait();
+      bool one_by_one = true;
+      for (int i = 1; i <= 3; ++i)
+      {
+        event.set();
+        co_await cf::sleep_for(10ms);
+        one_by_one = one_by_one && continued == i;
+      }
+      co_return one_by_one;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [first, second, third, one_by_one] =
+          co_await cf::when_all(waiter(), waiter(), waiter(), setter());
+      co_return one_by_one;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(event.is_set() == false);
+    // The signal is kept for the next waiter
+    event.set();
+    REQUIRE(event.is_set());
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Condition variable hands over items under the mutex",
+                 "[async_condition_variable]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(4);
+    cf::async_mutex mutex;
+    cf::async_condition_variable not_empty;
+    std::deque<int> queue;
+    bool closed = false;
+    constexpr int c_items = 200;
+
+    auto consumer = [&]() -> cf::task<int>
+    {
+      int sum = 0;
+      auto lock = co_await mutex.lock();
+      while (true)
+      {
+        while (queue.empty() && closed == false)
+        {
+          co_await not_empty.wait(lock);
+        }
+        if (queue.empty())
+        {
+          co_return sum;
+        }
+        sum += queue.front();
+        queue.pop_front();
+      }
+    };
+    auto producer = [&]() -> cf::task<int>
+    {
+      for (int i = 1; i <= c_items; ++i)
+      {
+        {
+          auto lock = co_await mutex.lock();
+          queue.push_back(i);
+          not_empty.notify_one();
+        }
+        if (i % 50 == 0)
+        {
+          co_await cf::sleep_for(1ms);
+        }
+      }
+      auto lock = co_await mutex.lock();
+      closed = true;
+      not_empty.notify_all();
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      auto [first, second, third, produced] =
+          co_await cf::when_all(consumer(), consumer(), consumer(), producer());
+      co_return first + second + third;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == c_items * (c_items + 1) / 2);
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Stop request cancels the waiters",
+                 "[async_semaphore][async_event][async_latch]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_semaphore semaphore(0);
+    cf::async_event event;
+    cf::async_latch latch(1);
+    std::stop_source stop_source;
+    std::atomic_int cancelled{ 0 };
+    auto [waiting_event, waiting_token] = event_t::create("waiting");
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto coro = [&]() -> cf::task<int>
+    {
+      waiting_event.trigger();
+      try
+      {
+        co_await semaphore.acquire();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled;
+      }
+      // The stop is already requested, they don't suspend
+      try
+      {
+        co_await event.wait();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled;
+      }
+      try
+      {
+        co_await latch.wait();
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        ++cancelled;
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    REQUIRE(waiting_token.is_triggered(c_test_case_timeout));
+    std::this_thread::sleep_for(10ms);
+    stop_source.request_stop();
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(cancelled == 3);
+    // The cancelled waiter left the queue, the permit isn't handed over
+    semaphore.release();
+    REQUIRE(semaphore.available() == 1);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Cancelled condition variable wait owns the mutex again",
+                 "[async_condition_variable]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    cf::async_mutex mutex;
+    cf::async_condition_variable condition_variable;
+    std::stop_source stop_source;
+    std::atomic_bool cancelled_with_lock{ false };
+    auto [locked_event, locked_token] = event_t::create("locked");
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto coro = [&]() -> cf::task<int>
+    {
+      {
+        auto lock = co_await mutex.lock();
+        locked_event.trigger();
+        try
+        {
+          co_await condition_variable.wait(lock);
+        }
+        catch (const cf::operation_cancelled_error&)
+        {
+          cancelled_with_lock = mutex.try_lock() == false;
+        }
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    // The mutex is released when the coroutine waits
+    REQUIRE(locked_token.is_triggered(c_test_case_timeout));
+    while (mutex.try_lock() == false)
+    {
+      std::this_thread::yield();
+    }
+    mutex.unlock();
+    stop_source.request_stop();
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(cancelled_with_lock);
+    // A notification doesn't find the cancelled waiter
+    condition_variable.notify_all();
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+  memory_checker.check();
+}
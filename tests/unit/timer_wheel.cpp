@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+
+#include <coroutine_flow/__details/timer_wheel.hpp>
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+using time_point_t = cf::timer_clock_t::time_point;
+
+// Executes the expired callbacks
+void advance(cf::timer_wheel& wheel, time_point_t now)
+{
+  std::vector<std::function<void()>> expired;
+  wheel.advance(now, expired);
+  for (auto& callback : expired)
+  {
+    callback();
+  }
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Timers of every level expire in order and never early",
+                 "[timer_wheel]")
+{
+  const time_point_t origin = cf::timer_clock_t::now();
+  cf::timer_wheel wheel(origin);
+  const std::vector<cf::timer_clock_t::duration> delays{
+    5ms, 300ms, 70s, 2h, 1500us, 256ms
+  };
+  std::vector<time_point_t> expired_at;
+  time_point_t now = origin;
+  for (const auto delay : delays)
+  {
+    wheel.schedule_at(origin + delay,
+                      [&, delay]
+                      {
+                        REQUIRE(now >= origin + delay);
+                        expired_at.push_back(origin + delay);
+                      });
+  }
+  REQUIRE(wheel.size() == delays.size());
+
+  // Stepping with the next wake up must not skip any timer
+  while (wheel.empty() == false)
+  {
+    const auto wake_up = wheel.next_wake_up();
+    REQUIRE(wake_up.has_value());
+    REQUIRE(*wake_up > now);
+    now = *wake_up;
+    advance(wheel, now);
+  }
+  REQUIRE(expired_at == std::vector<time_point_t>{ origin + 1500us,
+                                                   origin + 5ms,
+                                                   origin + 256ms,
+                                                   origin + 300ms,
+                                                   origin + 70s,
+                                                   origin + 2h });
+  // At most one tick late
+  REQUIRE(now - (origin + 2h) <= 1ms);
+  REQUIRE(wheel.next_wake_up().has_value() == false);
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Cancelled timers don't expire",
+                 "[timer_wheel]")
+{
+  const time_point_t origin = cf::timer_clock_t::now();
+  cf::timer_wheel wheel(origin);
+  int expired_count = 0;
+  auto on_expired = [&] { ++expired_count; };
+
+  const auto cancelled = wheel.schedule_at(origin + 10ms, on_expired);
+  const auto kept = wheel.schedule_at(origin + 10ms, on_expired);
+  const auto far = wheel.schedule_at(origin + 1h, on_expired);
+  REQUIRE(wheel.cancel(cancelled));
+  REQUIRE(wheel.cancel(cancelled) == false);
+  REQUIRE(wheel.cancel(far));
+
+  // The slot of the cancelled timer is reused, the old id is invalid
+  const auto reused = wheel.schedule_at(origin + 20ms, on_expired);
+  REQUIRE(reused.index == cancelled.index || reused.index == far.index);
+  REQUIRE(wheel.cancel(cancelled) == false);
+  REQUIRE(wheel.cancel(far) == false);
+  REQUIRE(wheel.size() == 2);
+
+  advance(wheel, origin + 2h);
+  REQUIRE(expired_count == 2);
+  REQUIRE(wheel.cancel(kept) == false);
+  REQUIRE(wheel.empty());
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Expired timers fire at the next tick",
+                 "[timer_wheel]")
+{
+  const time_point_t origin = cf::timer_clock_t::now();
+  cf::timer_wheel wheel(origin);
+  advance(wheel, origin + 10ms);
+
+  int expired_count = 0;
+  wheel.schedule_at(origin, [&] { ++expired_count; });
+  advance(wheel, origin + 10ms);
+  REQUIRE(expired_count == 0);
+  advance(wheel, origin + 11ms);
+  REQUIRE(expired_count == 1);
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Timers with the same expiry fire in the order of scheduling",
+                 "[timer_wheel]")
+{
+  const time_point_t origin = cf::timer_clock_t::now();
+  cf::timer_wheel wheel(origin);
+  std::vector<char> expired;
+  auto schedule = [&](char name)
+  {
+    return wheel.schedule_at(origin + 300ms,
+                             [&, name] { expired.push_back(name); });
+  };
+
+  // Too far for the lowest level, they are cascaded
+  schedule('A');
+  schedule('B');
+  advance(wheel, origin + 100ms);
+  schedule('C');
+  schedule('D');
+  REQUIRE(wheel.cancel(schedule('E')));
+  schedule('F');
+
+  advance(wheel, origin + 400ms);
+  REQUIRE(expired == std::vector<char>{ 'A', 'B', 'C', 'D', 'F' });
+}
@@ -0,0 +1,189 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_all.hpp>
+
+#include <atomic>
+#include <stop_token>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Results of every child are collected",
+                 "[when_all]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto number = [](int value) -> cf::task<int> { co_return value; };
+    auto text = []() -> cf::task<std::string> { co_return "text"; };
+    auto coro = [&]() -> cf::task<int>
+    {
+      auto [first, second, third] =
+          co_await cf::when_all(number(1), text(), number(2));
+      REQUIRE(second == "text");
+
+      std::vector<cf::task<int>> children;
+      for (int i = 0; i < 10; ++i)
+      {
+        children.push_back(number(i));
+      }
+      const std::vector<int> values =
+          co_await cf::when_all(std::move(children));
+      REQUIRE(values == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+      REQUIRE((co_await cf::when_all(std::vector<cf::task<int>>{})).empty());
+      co_return first + third;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 3);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Children run concurrently",
+                 "[when_all]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    auto [first_event, first_token] = event_t::create("first started");
+    auto [second_event, second_token] = event_t::create("second started");
+
+    // Both of them are blocked until the other one is started
+    auto first = [&]() -> cf::task<bool>
+    {
+      first_event.trigger();
+      co_return second_token.is_triggered(c_test_case_timeout);
+    };
+    auto second = [&]() -> cf::task<bool>
+    {
+      second_event.trigger();
+      co_return first_token.is_triggered(c_test_case_timeout);
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      auto [first_result, second_result] =
+          co_await cf::when_all(first(), second());
+      co_return first_result && second_result;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Exception is rethrown after every child is finished",
+                 "[when_all]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::atomic_int finished_children{ 0 };
+
+    auto throwing_child = [&]() -> cf::task<int>
+    {
+      ++finished_children;
+      throw test_exception_t{};
+      co_return 0;
+    };
+    auto child = [&]() -> cf::task<int>
+    {
+      ++finished_children;
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> children;
+      children.push_back(child());
+      children.push_back(throwing_child());
+      children.push_back(child());
+      REQUIRE_THROWS_AS(co_await cf::when_all(std::move(children)),
+                        test_exception_t);
+      REQUIRE(finished_children == 3);
+      co_return 0;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 0);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Stop request is forwarded and every child is awaited",
+                 "[when_all]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    std::stop_source stop_source;
+    std::atomic_int finished_children{ 0 };
+    std::atomic_bool cancelled{ false };
+    auto [sleeping_event, sleeping_token] = event_t::create("sleeping");
+    auto [working_event, working_token] = event_t::create("working");
+    auto [release_event, release_token] = event_t::create("release");
+    auto [finished_event, finished_token] = event_t::create("finished");
+
+    auto sleeping_child = [&]() -> cf::task<int>
+    {
+      sleeping_event.trigger();
+      co_await cf::sleep_for(1h);
+      co_return 1;
+    };
+    // It doesn't look at the stop token
+    auto working_child = [&]() -> cf::task<int>
+    {
+      working_event.trigger();
+      release_token.is_triggered(c_test_case_timeout);
+      ++finished_children;
+      co_return 2;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await cf::when_all(sleeping_child(), working_child());
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        cancelled = true;
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    cf::run_async(coro(), &thread_pool, stop_source.get_token());
+
+    REQUIRE(sleeping_token.is_triggered(c_test_case_timeout));
+    REQUIRE(working_token.is_triggered(c_test_case_timeout));
+    stop_source.request_stop();
+    // The sleep is interrupted but the other child is still running
+    REQUIRE_FALSE(finished_token.is_triggered(50ms));
+    release_event.trigger();
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    REQUIRE(cancelled);
+    REQUIRE(finished_children == 1);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/when_any.hpp>
+
+#include <chrono>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "First finished child is reported",
+                 "[when_any]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto slow_number = []() -> cf::task<int>
+    {
+      co_await cf::sleep_for(1h);
+      co_return 1;
+    };
+    auto text = []() -> cf::task<std::string> { co_return "fast"; };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      const std::variant<int, std::string> result =
+          co_await cf::when_any(slow_number(), text());
+      co_return result.index() == 1 && std::get<1>(result) == "fast";
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Losers are stopped and destroyed",
+                 "[when_any]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    auto [stopped_event, stopped_token] = event_t::create("loser stopped");
+
+    auto loser = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await cf::sleep_for(1h);
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        stopped_event.trigger();
+        throw;
+      }
+      co_return 0;
+    };
+    auto winner = []() -> cf::task<int>
+    {
+      co_await cf::sleep_for(10ms);
+      co_return 42;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      std::vector<cf::task<int>> children;
+      children.push_back(loser());
+      children.push_back(winner());
+      children.push_back(loser());
+      const cf::when_any_result<int> result =
+          co_await cf::when_any(std::move(children));
+      REQUIRE(result.index == 1);
+      co_return result.value;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 42);
+    REQUIRE(stopped_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Exception of the winner is rethrown",
+                 "[when_any]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto slow_child = []() -> cf::task<int>
+    {
+      co_await cf::sleep_for(1h);
+      co_return 1;
+    };
+    auto throwing_child = []() -> cf::task<int>
+    {
+      throw test_exception_t{};
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      REQUIRE_THROWS_AS(co_await cf::when_any(slow_child(), throwing_child()),
+                        test_exception_t);
+      co_return 0;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 0);
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+#include <coroutine_flow/__details/testing/test_exception.hpp>
+
+#include <coroutine_flow/schedulers/priority_thread_pool.hpp>
+#include <coroutine_flow/sleep.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/with_timeout.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace cf = coroutine_flow;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+using cf::__details::testing::test_exception_t;
+
+using namespace std::chrono_literals;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Child that finishes in time provides its result",
+                 "[with_timeout]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto child = []() -> cf::task<int> { co_return 42; };
+    auto throwing_child = []() -> cf::task<int>
+    {
+      throw test_exception_t{};
+      co_return 0;
+    };
+    auto coro = [&]() -> cf::task<int>
+    {
+      const std::expected<int, cf::timeout_error> result =
+          co_await cf::with_timeout(child(), 10s);
+      REQUIRE(result.has_value());
+      REQUIRE_THROWS_AS(co_await cf::with_timeout(throwing_child(), 10s),
+                        test_exception_t);
+      co_return *result;
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == 42);
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Slow child is abandoned at the deadline",
+                 "[with_timeout]")
+{
+  memory_check_t memory_checker;
+  {
+    auto [release_event, release_token] = event_t::create("release");
+    std::atomic_bool child_finished{ false };
+    // Destroyed first, it waits for the child
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+
+    auto slow_child = [&]() -> cf::task<int>
+    {
+      // Blocks its worker until the test releases it
+      REQUIRE(release_token.is_triggered(c_test_case_timeout));
+      child_finished = true;
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      const auto result = co_await cf::with_timeout(slow_child(), 20ms);
+      co_return result.has_value() == false &&
+          result.error() == cf::timeout_error{};
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool));
+    REQUIRE(child_finished == false);
+    release_event.trigger();
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Abandoned child is stopped",
+                 "[with_timeout]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::priority_thread_pool_t thread_pool(2);
+    auto [stopped_event, stopped_token] = event_t::create("child stopped");
+
+    auto sleeping_child = [&]() -> cf::task<int>
+    {
+      try
+      {
+        co_await cf::sleep_for(1h);
+      }
+      catch (const cf::operation_cancelled_error&)
+      {
+        stopped_event.trigger();
+        throw;
+      }
+      co_return 1;
+    };
+    auto coro = [&]() -> cf::task<bool>
+    {
+      const auto result = co_await cf::with_timeout(sleeping_child(), 20ms);
+      co_return result.has_value();
+    };
+
+    REQUIRE(cf::sync_wait(coro(), &thread_pool) == false);
+    REQUIRE(stopped_token.is_triggered(c_test_case_timeout));
+  }
+  memory_checker.check();
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <coroutine_flow/__details/testing/base_test_case.hpp>
+#include <coroutine_flow/__details/testing/event.hpp>
+#include <coroutine_flow/__details/testing/memory_check.hpp>
+#include <coroutine_flow/__details/testing/test_config.hpp>
+
+#include <coroutine_flow/schedulers/elastic_thread_pool.hpp>
+#include <coroutine_flow/task.hpp>
+#include <coroutine_flow/yield.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cf = coroutine_flow;
+using namespace std::chrono_literals;
+
+using cf::__details::testing::base_test_case_t;
+using cf::__details::testing::event_t;
+using cf::__details::testing::memory_check_t;
+
+constexpr const auto c_test_case_timeout =
+    cf::__details::testing::c_test_case_timeout;
+
+namespace
+{
+struct counting_scheduler_t
+{
+    cf::schedulers::elastic_thread_pool_t* pool;
+    std::atomic_int* schedule_count;
+};
+
+void tag_invoke(cf::schedule_task_t,
+                counting_scheduler_t scheduler,
+                std::function<void()> callback)
+{
+  ++*scheduler.schedule_count;
+  scheduler.pool->push(std::move(callback));
+}
+
+cf::task<int> nested(int depth)
+{
+  if (depth == 0)
+  {
+    co_return 0;
+  }
+  co_return co_await nested(depth - 1) + 1;
+}
+} // namespace
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Yield lets the other tasks run",
+                 "[yield]")
+{
+  memory_check_t memory_checker;
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    auto record = [&](std::string value)
+    {
+      std::lock_guard lock(order_mutex);
+      order.push_back(std::move(value));
+    };
+    std::promise<void> release_worker;
+    auto blocker = [&]() -> cf::task<int>
+    {
+      release_worker.get_future().wait();
+      co_return 0;
+    };
+    auto [finished_event, finished_token] = event_t::create("long finished");
+    auto long_running = [&]() -> cf::task<int>
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        record("long_" + std::to_string(i));
+        co_await cf::yield();
+      }
+      finished_event.trigger();
+      co_return 0;
+    };
+    auto short_running = [&]() -> cf::task<int>
+    {
+      record("short");
+      co_return 0;
+    };
+
+    // Both of them are queued before the worker gets free
+    cf::run_async(blocker(), &thread_pool);
+    cf::run_async(long_running(), &thread_pool);
+    cf::run_async(short_running(), &thread_pool);
+    release_worker.set_value();
+
+    REQUIRE(finished_token.is_triggered(c_test_case_timeout));
+    std::lock_guard lock(order_mutex);
+    REQUIRE(order == std::vector<std::string>{
+                         "long_0", "short", "long_1", "long_2" });
+  }
+  memory_checker.check();
+}
+
+TEST_CASE_METHOD(base_test_case_t,
+                 "Exhausted inline resume budget schedules the continuation",
+                 "[yield]")
+{
+  memory_check_t memory_checker;
+  const std::size_t original_budget = cf::inline_resume_budget();
+  {
+    cf::schedulers::elastic_thread_pool_t thread_pool(
+        { .min_threads = 1, .max_threads = 1 });
+    constexpr int c_depth = 64;
+
+    std::atomic_int unlimited_count{ 0 };
+    cf::set_inline_resume_budget(c_depth * 2);
+    REQUIRE(cf::sync_wait(nested(c_depth),
+                          counting_scheduler_t{ &thread_pool,
+                                                &unlimited_count }) ==
+            c_depth);
+
+    std::atomic_int limited_count{ 0 };
+    cf::set_inline_resume_budget(4);
+    REQUIRE(
+        cf::sync_wait(nested(c_depth),
+                      counting_scheduler_t{ &thread_pool, &limited_count }) ==
+        c_depth);
+
+    // Every nested coroutine is scheduled once
+    REQUIRE(unlimited_count == c_depth + 1);
+    // The synchronously finishing chain is split into smaller pieces
+    REQUIRE(limited_count >= unlimited_count + c_depth / 4 - 1);
+  }
+  cf::set_inline_resume_budget(original_budget);
+  memory_checker.check();
+}